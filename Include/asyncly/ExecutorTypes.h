@@ -47,19 +47,41 @@ using IStrandPtr = std::shared_ptr<IStrand>;
 class IExecutorController;
 using IExecutorControllerUPtr = std::unique_ptr<IExecutorController>;
 
+class IRunnableScheduler;
 class SchedulerThread;
 
+/// What a periodic task does about ticks it missed, because its scheduler woke up late or
+/// because its previous run is still queued on the executor.
+enum class CatchUpPolicy {
+    /// every missed tick is run, back to back, until the schedule has caught up
+    Burst,
+    /// missed ticks are dropped, a tick is only run if it is not more than a period late
+    Skip,
+    /// missed ticks are merged into a single run
+    Coalesce,
+};
+
 using ThreadInitFunction = std::function<void()>;
+using RunnableSchedulerFactory = std::function<std::shared_ptr<IRunnableScheduler>()>;
 
 struct ThreadPoolConfig {
     std::string name;
     std::vector<ThreadInitFunction> executorInitFunctions;
     ThreadInitFunction schedulerInitFunction;
+    /// creates the scheduler run by the scheduler thread, a DefaultScheduler if empty
+    RunnableSchedulerFactory schedulerFactory;
+    /// lets the worker threads service the timers themselves instead of a scheduler thread: an
+    /// idle worker waits for the next deadline and puts the expired timers into the task queue.
+    /// Saves the scheduler thread and a thread switch per timer, but timers may be late while all
+    /// workers are busy with long running tasks. schedulerFactory is ignored if set.
+    bool workerTimers = false;
 };
 
 struct ThreadConfig {
     ThreadInitFunction executorInitFunction;
     ThreadInitFunction schedulerInitFunction;
+    /// creates the scheduler run by the scheduler thread, a DefaultScheduler if empty
+    RunnableSchedulerFactory schedulerFactory;
 };
 
 } // namespace asyncly
@@ -19,9 +19,20 @@
 #pragma once
 
 #include "asyncly/future/AddTimeout.h"
+#include "asyncly/future/AsyncCache.h"
+#include "asyncly/future/AsyncMutex.h"
+#include "asyncly/future/AsyncSemaphore.h"
+#include "asyncly/future/Batcher.h"
+#include "asyncly/future/Channel.h"
 #include "asyncly/future/Future.h"
+#include "asyncly/future/Hedge.h"
 #include "asyncly/future/LazyOneTimeInitializer.h"
+#include "asyncly/future/Parallel.h"
+#include "asyncly/future/Retry.h"
+#include "asyncly/future/SharedFuture.h"
 #include "asyncly/future/Split.h"
+#include "asyncly/future/TaskGraph.h"
 #include "asyncly/future/WhenAll.h"
 #include "asyncly/future/WhenAny.h"
+#include "asyncly/future/WhenN.h"
 #include "asyncly/future/WhenThen.h"
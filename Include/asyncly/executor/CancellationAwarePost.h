@@ -0,0 +1,111 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/task/CancellationToken.h"
+
+namespace asyncly {
+
+namespace detail {
+// Owned by the scheduled task, so the token registration is dropped as soon as the task is run
+// or cancelled and the token does not accumulate callbacks of expired timers.
+struct CancellationAwareTimer {
+    std::mutex mutex;
+    bool done = false;
+    CancellationRegistration registration;
+
+    void release()
+    {
+        CancellationRegistration released;
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            done = true;
+            released = std::move(registration);
+        }
+    }
+
+    void store(CancellationRegistration&& newRegistration)
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        if (!done) {
+            registration = std::move(newRegistration);
+        }
+    }
+};
+
+template <typename Post>
+std::shared_ptr<Cancelable> post_cancellation_aware(
+    Post&& post, Task&& task, const CancellationToken& token)
+{
+    auto timer = std::make_shared<CancellationAwareTimer>();
+    auto cancelable = post([timer, task = std::move(task)]() mutable {
+        timer->release();
+        task();
+    });
+
+    timer->store(token.on_cancel([weakCancelable = std::weak_ptr<Cancelable>{ cancelable }]() {
+        if (auto cancelable = weakCancelable.lock()) {
+            cancelable->cancel();
+        }
+    }));
+    return cancelable;
+}
+} // namespace detail
+
+///
+/// post_at schedules `task` on `executor` like IExecutor::post_at and
+/// additionally cancels it once `token` is cancelled. Cancelling
+/// releases the task and everything it captured right away instead of
+/// at the deadline. If `token` is already cancelled, the task is
+/// never run.
+///
+inline std::shared_ptr<Cancelable> post_at(
+    const IExecutorPtr& executor,
+    const clock_type::time_point& absTime,
+    Task&& task,
+    const CancellationToken& token)
+{
+    return detail::post_cancellation_aware(
+        [&executor, &absTime](Task&& t) { return executor->post_at(absTime, std::move(t)); },
+        std::move(task),
+        token);
+}
+
+///
+/// post_after schedules `task` on `executor` like
+/// IExecutor::post_after and additionally cancels it once `token` is
+/// cancelled, see post_at above.
+///
+inline std::shared_ptr<Cancelable> post_after(
+    const IExecutorPtr& executor,
+    const clock_type::duration& relTime,
+    Task&& task,
+    const CancellationToken& token)
+{
+    return detail::post_cancellation_aware(
+        [&executor, &relTime](Task&& t) { return executor->post_after(relTime, std::move(t)); },
+        std::move(task),
+        token);
+}
+
+} // namespace asyncly
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/task/AutoCancelable.h"
+#include "asyncly/task/detail/PeriodicTask.h"
+
+namespace asyncly {
+
+///
+/// post_periodically runs `task` on `executor` every `period` like
+/// IExecutor::post_periodically, with `policy` deciding what happens
+/// to ticks which are missed because the scheduler or the executor
+/// is late. IExecutor::post_periodically behaves like
+/// CatchUpPolicy::Burst.
+///
+/// If the scheduler of `executor` supports native periodic timers,
+/// every tick is handed to `executor` with post() instead of
+/// post_at(), so a metrics wrapper counts the ticks as immediate
+/// tasks. Its own post_periodically keeps counting them as timed.
+///
+/// \snippet PeriodicTaskTest.cpp Post Periodically With Policy
+///
+[[nodiscard]] inline std::shared_ptr<AutoCancelable> post_periodically(
+    const IExecutorPtr& executor,
+    const clock_type::duration& period,
+    CatchUpPolicy policy,
+    RepeatableTask&& task)
+{
+    if (!task) {
+        throw std::runtime_error("invalid closure");
+    }
+    return std::make_shared<AutoCancelable>(
+        detail::PeriodicTask::create(period, std::move(task), executor, policy));
+}
+
+} // namespace asyncly
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/scheduler/IScheduler.h"
+
+namespace asyncly {
+
+///
+/// post_at schedules `task` on `executor` like IExecutor::post_at, but
+/// allows it to run up to `slack` after `absTime`. Timers whose windows
+/// overlap can then be handled by a single wakeup of the scheduler and
+/// are posted to their executor as a single task. Tasks never run
+/// before `absTime`.
+///
+/// Use it for timers which tolerate some lateness, like heartbeats,
+/// metrics flushes or cache expiries. Schedulers without support for
+/// slack run the task at `absTime` like IExecutor::post_at does.
+///
+/// \snippet TimerSlackTest.cpp Post With Slack
+///
+inline std::shared_ptr<Cancelable> post_at(
+    const IExecutorPtr& executor,
+    const clock_type::time_point& absTime,
+    const clock_type::duration& slack,
+    Task&& task)
+{
+    const auto scheduler = executor->get_scheduler();
+    if (!scheduler) {
+        return executor->post_at(absTime, std::move(task));
+    }
+    if (!task) {
+        throw std::runtime_error("invalid closure");
+    }
+    task.maybe_set_executor(executor);
+    return scheduler->execute_at_with_slack(executor, absTime, slack, std::move(task));
+}
+
+///
+/// post_after schedules `task` on `executor` like
+/// IExecutor::post_after, but allows it to run up to `slack` late,
+/// see post_at above.
+///
+inline std::shared_ptr<Cancelable> post_after(
+    const IExecutorPtr& executor,
+    const clock_type::duration& relTime,
+    const clock_type::duration& slack,
+    Task&& task)
+{
+    return post_at(executor, executor->now() + relTime, slack, std::move(task));
+}
+
+} // namespace asyncly
@@ -23,11 +23,13 @@
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <utility>
 
 #include "asyncly/ExecutorTypes.h"
 #include "asyncly/executor/ExecutorStoppedException.h"
 #include "asyncly/executor/IExecutor.h"
 #include "asyncly/scheduler/IScheduler.h"
+#include "asyncly/scheduler/detail/WorkerScheduler.h"
 #include "asyncly/task/detail/PeriodicTask.h"
 
 namespace asyncly {
@@ -47,6 +49,10 @@ class ThreadPoolExecutor final : public Base,
     static std::shared_ptr<ThreadPoolExecutor>
     create(const std::string& name, const asyncly::ISchedulerPtr& scheduler);
 
+    /// creates an executor whose worker threads service the timers of `workerScheduler`
+    static std::shared_ptr<ThreadPoolExecutor> create(
+        const std::string& name, const std::shared_ptr<detail::WorkerScheduler>& workerScheduler);
+
     ThreadPoolExecutor(ThreadPoolExecutor const&) = delete;
     ThreadPoolExecutor& operator=(ThreadPoolExecutor const&) = delete;
 
@@ -63,11 +69,23 @@ class ThreadPoolExecutor final : public Base,
     ISchedulerPtr get_scheduler() const override;
 
   private:
-    ThreadPoolExecutor(const std::string& name, const asyncly::ISchedulerPtr& scheduler);
+    ThreadPoolExecutor(
+        const std::string& name,
+        const asyncly::ISchedulerPtr& scheduler,
+        const std::shared_ptr<detail::WorkerScheduler>& workerScheduler);
+
+    // waits until there is a task to run, the timers are due or the executor is shut down. Returns
+    // true if the timers are due, the caller then owns them until releaseTimers_().
+    bool wait_(std::unique_lock<std::mutex>& lock);
+    void releaseTimers_();
+    void expireTimersIfDue_();
+    void wakeUpTimerOwner_();
 
   private:
     std::mutex m_mutex;
     std::condition_variable m_condition;
+    // the timer owner waits on its own condition, so that it can be woken up alone
+    std::condition_variable m_timerCondition;
     unsigned int m_activeThreads;
     std::queue<Task> m_taskQueue;
 
@@ -76,23 +94,49 @@ class ThreadPoolExecutor final : public Base,
 
     const std::string m_name;
     const ISchedulerPtr m_scheduler;
+
+    // set if the worker threads service the timers, one idle worker at a time owns them and
+    // waits for or expires them
+    const std::shared_ptr<detail::WorkerScheduler> m_workerScheduler;
+    bool m_hasTimerOwner;
+    // idle workers waiting for tasks while another one owns the timers
+    size_t m_idleWorkers;
 };
 
 template <typename Base>
 std::shared_ptr<ThreadPoolExecutor<Base>>
 ThreadPoolExecutor<Base>::create(const std::string& name, const asyncly::ISchedulerPtr& scheduler)
 {
-    return std::shared_ptr<ThreadPoolExecutor>(new ThreadPoolExecutor(name, scheduler));
+    return std::shared_ptr<ThreadPoolExecutor>(new ThreadPoolExecutor(name, scheduler, {}));
+}
+
+template <typename Base>
+std::shared_ptr<ThreadPoolExecutor<Base>> ThreadPoolExecutor<Base>::create(
+    const std::string& name, const std::shared_ptr<detail::WorkerScheduler>& workerScheduler)
+{
+    auto executor = std::shared_ptr<ThreadPoolExecutor>(
+        new ThreadPoolExecutor(name, workerScheduler, workerScheduler));
+    workerScheduler->setWakeupFunction([weakExecutor = std::weak_ptr{ executor }]() {
+        if (auto executor = weakExecutor.lock()) {
+            executor->wakeUpTimerOwner_();
+        }
+    });
+    return executor;
 }
 
 template <typename Base>
 ThreadPoolExecutor<Base>::ThreadPoolExecutor(
-    const std::string& name, const asyncly::ISchedulerPtr& scheduler)
+    const std::string& name,
+    const asyncly::ISchedulerPtr& scheduler,
+    const std::shared_ptr<detail::WorkerScheduler>& workerScheduler)
     : m_activeThreads(0)
     , m_isShutdownActive(false)
     , m_isStopped(false)
     , m_name(name)
     , m_scheduler(scheduler)
+    , m_workerScheduler(workerScheduler)
+    , m_hasTimerOwner(false)
+    , m_idleWorkers(0)
 {
 }
 
@@ -145,14 +189,21 @@ template <typename Base> void ThreadPoolExecutor<Base>::post(Task&& closure)
         throw std::runtime_error(m_name + ": invalid closure");
     }
     closure.maybe_set_executor(this->weak_from_this());
+    bool wakeUpTimerOwner;
     {
         std::lock_guard lock{ m_mutex };
         if (m_isStopped) {
             throw ExecutorStoppedException(m_name + ": executor stopped");
         }
         m_taskQueue.push(std::move(closure));
+        // the timer owner only runs the tasks the other idle workers cannot take
+        wakeUpTimerOwner = m_hasTimerOwner && m_taskQueue.size() > m_idleWorkers;
+    }
+    if (wakeUpTimerOwner) {
+        m_timerCondition.notify_one();
+    } else {
+        m_condition.notify_one();
     }
-    m_condition.notify_one();
 }
 
 template <typename Base> void ThreadPoolExecutor<Base>::finish()
@@ -162,6 +213,7 @@ template <typename Base> void ThreadPoolExecutor<Base>::finish()
         m_isShutdownActive = true;
     }
     m_condition.notify_all();
+    m_timerCondition.notify_all();
 }
 
 template <typename Base> void ThreadPoolExecutor<Base>::run()
@@ -176,9 +228,17 @@ template <typename Base> void ThreadPoolExecutor<Base>::run()
     while (true) {
         std::unique_lock lock{ m_mutex };
 
-        m_condition.wait(lock, [this] {
-            return !m_taskQueue.empty() || m_isShutdownActive;
-        }); // wait does not throw since C++14
+        if (wait_(lock)) {
+            // the task queue is empty, the timers put their tasks there
+            lock.unlock();
+            if (!m_workerScheduler->expire()) {
+                // a busy worker is expiring them, the owner waits for it instead of spinning
+                m_workerScheduler->waitAndExpire();
+            }
+            lock.lock();
+            releaseTimers_();
+            continue;
+        }
 
         if (m_isShutdownActive && m_taskQueue.empty()) {
             assert(!m_isStopped);
@@ -190,7 +250,74 @@ template <typename Base> void ThreadPoolExecutor<Base>::run()
         auto task = std::move(m_taskQueue.front());
         m_taskQueue.pop();
         lock.unlock();
+        // timers do not have to wait for an idle worker while the pool is busy
+        expireTimersIfDue_();
         task();
     }
 }
+
+template <typename Base> bool ThreadPoolExecutor<Base>::wait_(std::unique_lock<std::mutex>& lock)
+{
+    if (!m_workerScheduler) {
+        m_condition.wait(lock, [this] {
+            return !m_taskQueue.empty() || m_isShutdownActive;
+        }); // wait does not throw since C++14
+        return false;
+    }
+
+    while (m_taskQueue.empty() && !m_isShutdownActive) {
+        if (m_hasTimerOwner) {
+            ++m_idleWorkers;
+            m_condition.wait(lock);
+            --m_idleWorkers;
+            continue;
+        }
+        m_hasTimerOwner = true;
+        const auto nextExpiry = m_workerScheduler->nextExpiry();
+        if (nextExpiry && *nextExpiry <= m_workerScheduler->now()) {
+            return true;
+        }
+        if (nextExpiry) {
+            m_timerCondition.wait_until(lock, *nextExpiry);
+        } else {
+            m_timerCondition.wait(lock);
+        }
+        releaseTimers_();
+    }
+    return false;
+}
+
+template <typename Base> void ThreadPoolExecutor<Base>::releaseTimers_()
+{
+    m_hasTimerOwner = false;
+    if (!m_taskQueue.empty() && !m_isShutdownActive) {
+        // the owner leaves to run a task, another idle worker has to take over the timers
+        m_condition.notify_one();
+    }
+}
+
+template <typename Base> void ThreadPoolExecutor<Base>::expireTimersIfDue_()
+{
+    if (!m_workerScheduler) {
+        return;
+    }
+    // nextExpiry() does not lock, so the timer queue is only locked once the timers are due
+    const auto nextExpiry = m_workerScheduler->nextExpiry();
+    if (nextExpiry && *nextExpiry <= m_workerScheduler->now()) {
+        m_workerScheduler->expire();
+    }
+}
+
+template <typename Base> void ThreadPoolExecutor<Base>::wakeUpTimerOwner_()
+{
+    {
+        // the lock makes sure that the owner either sees the new deadline or is notified
+        std::lock_guard lock{ m_mutex };
+        if (!m_hasTimerOwner) {
+            // the next idle worker sees the new deadline
+            return;
+        }
+    }
+    m_timerCondition.notify_one();
+}
 } // namespace asyncly
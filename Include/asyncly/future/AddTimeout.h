@@ -18,16 +18,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+
+#include "asyncly/executor/CurrentExecutor.h"
 #include "asyncly/future/Future.h"
-#include "asyncly/future/Split.h"
-#include "asyncly/future/WhenAny.h"
+#include "asyncly/task/Cancelable.h"
 
 namespace asyncly {
 
-namespace {
-template <typename T> struct TimeoutVisitor;
-} // namespace
-
 /// Timeout is thrown when a timeout augmented future times out.
 struct Timeout : public std::exception {
     const char* what() const noexcept override
@@ -36,9 +35,41 @@ struct Timeout : public std::exception {
     }
 };
 
+namespace detail {
+/// Shared by the timer and the continuations of the augmented future, whichever completes first
+/// settles the promise and cancels the other one.
+template <typename T> struct add_timeout_state {
+    add_timeout_state(Promise<T> p, std::weak_ptr<FutureImpl<T>> s)
+        : promise{ std::move(p) }
+        , source{ std::move(s) }
+    {
+    }
+
+    bool try_complete()
+    {
+        return !done.exchange(true, std::memory_order_acq_rel);
+    }
+
+    void cancel_source()
+    {
+        if (auto future = source.lock()) {
+            future->cancel();
+        }
+    }
+
+    std::atomic<bool> done{ false };
+    Promise<T> promise;
+    const std::weak_ptr<FutureImpl<T>> source;
+    // set before any continuation is attached, immutable afterwards
+    std::shared_ptr<Cancelable> timer;
+};
+} // namespace detail
+
 /// add_timeout augments the future passed to it by rejecting the future after a specified
 /// amount of time. The error the future is rejected with is asyncly::Timeout.
-/// add_timeout consumes the future passed to it.
+/// add_timeout consumes the future passed to it. When the timeout expires first, the augmented
+/// future is cancelled (see Future::cancel); when the augmented future is settled first, the
+/// timer is cancelled right away. Cancelling the returned future cancels both.
 ///
 /// Example usage:
 ///
@@ -63,55 +94,52 @@ Future<T> add_timeout(Duration duration, Future<T>&& future)
     static_assert(
         !std::is_same_v<T, Timeout>,
         "You cannot use this function with Future<Timeout>, it doesn't make any sense to try that");
-    auto timeoutReject = make_lazy_future<Timeout>();
-    auto timeoutFuture = std::get<0>(timeoutReject);
-    auto timeoutPromise = std::get<1>(timeoutReject);
-
-    auto cancelable = asyncly::this_thread::get_current_executor()->post_after(
-        duration,
-        [promise = std::move(timeoutPromise)]() mutable { promise.set_exception(Timeout{}); });
-
-    // we need to cancel the timer in case the future is rejected, but we still want the
-    // caller to handle errors independently. That's why we split the future and handle
-    // the error on the split-off part.
-    auto splitFuture = asyncly::split(std::move(future));
-    auto returnedFuture = std::get<0>(splitFuture);
-    auto errorAugmentedFuture = std::get<1>(splitFuture);
-    errorAugmentedFuture.catch_error([cancelable](auto) { cancelable->cancel(); });
-
-    auto combinedFuture = when_any(std::move(returnedFuture), std::move(timeoutFuture))
-                              .then([cancelable](auto variant) {
-                                  cancelable->cancel();
-                                  return std::visit(TimeoutVisitor<T>(), variant);
-                              });
-
-    return combinedFuture;
-}
+    using State = detail::add_timeout_state<T>;
 
-namespace {
-template <typename T> struct TimeoutVisitor {
-    T operator()(T value) const
-    {
-        return value;
-    }
+    auto lazy = make_lazy_future<T>();
+    auto state = std::make_shared<State>(std::get<1>(lazy), detail::get_future_impl(future));
 
-    T operator()(Timeout) const
-    {
-        throw std::runtime_error("Resolved timeout future, this should never happen: it "
-                                 "should always be rejected");
-    }
-};
+    state->timer
+        = asyncly::this_thread::get_current_executor()->post_after(duration, [state]() {
+              if (state->try_complete()) {
+                  state->promise.set_exception(Timeout{});
+                  state->cancel_source();
+              }
+          });
 
-template <> struct TimeoutVisitor<void> {
-    void operator()(std::monostate) const
-    {
-    }
+    state->promise.on_cancel([weakState = std::weak_ptr<State>{ state }]() {
+        if (auto state = weakState.lock(); state && state->try_complete()) {
+            state->timer->cancel();
+            state->cancel_source();
+        }
+    });
 
-    void operator()(Timeout) const
-    {
-        throw std::runtime_error("Resolved timeout future, this should never happen: it "
-                                 "should always be rejected");
+    auto onError = [state](std::exception_ptr e) {
+        if (state->try_complete()) {
+            state->timer->cancel();
+            state->promise.set_exception(e);
+        }
+    };
+    if constexpr (std::is_void_v<T>) {
+        std::move(future)
+            .then([state]() {
+                if (state->try_complete()) {
+                    state->timer->cancel();
+                    state->promise.set_value();
+                }
+            })
+            .catch_error(std::move(onError));
+    } else {
+        std::move(future)
+            .then([state](T value) {
+                if (state->try_complete()) {
+                    state->timer->cancel();
+                    state->promise.set_value(std::move(value));
+                }
+            })
+            .catch_error(std::move(onError));
     }
-};
-} // namespace
+
+    return std::get<0>(lazy);
+}
 } // namespace asyncly
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "asyncly/ExecutorTypes.h"
+#include "asyncly/executor/CurrentExecutor.h"
+#include "asyncly/future/Future.h"
+#include "asyncly/future/SharedFuture.h"
+#include "asyncly/future/detail/AsyncCache.h"
+
+namespace asyncly {
+
+struct AsyncCacheOptions {
+    /// time an entry stays in the cache after it has been loaded, no expiry if not set
+    std::optional<clock_type::duration> ttl;
+    /// number of entries after which the least recently used ones are evicted
+    std::size_t maxEntries = std::numeric_limits<std::size_t>::max();
+};
+
+///
+/// AsyncCache maps keys to values that are loaded asynchronously by
+/// a `Future` returning loader. Concurrent calls to `get` for a key
+/// that is not cached share a single call of the loader, so a burst
+/// of misses for the same key results in one load only. Values are
+/// stored once and handed out as `std::shared_ptr<const V>` without
+/// being copied.
+///
+/// Loaded entries expire after `options.ttl`, using a timer posted to
+/// the executor that was current when the cache was created. Once
+/// more than `options.maxEntries` keys are cached, the least recently
+/// used ones are evicted. Failed loads are not cached, the next call
+/// to `get` for that key calls the loader again. Evicting an entry
+/// does not affect callers still waiting for its load.
+///
+/// All member functions are thread-safe.
+///
+/// Example usage:
+/// \snippet AsyncCacheTest.cpp AsyncCache Get
+///
+template <typename K, typename V, typename Hash = std::hash<K>> class AsyncCache {
+  public:
+    using loader_t = std::function<Future<V>(const K&)>;
+
+    ///
+    /// Must be called from within an executor task, which is where
+    /// the expiry timers are posted to.
+    ///
+    explicit AsyncCache(loader_t loader, AsyncCacheOptions options = {})
+        : state_{ std::make_shared<detail::AsyncCacheState<K, V, Hash>>(
+            std::move(loader),
+            options.ttl,
+            options.maxEntries,
+            this_thread::get_current_executor()) }
+    {
+        if (options.maxEntries == 0) {
+            throw std::invalid_argument("AsyncCache needs room for at least one entry");
+        }
+    }
+
+    AsyncCache(const AsyncCache&) = delete;
+    AsyncCache& operator=(const AsyncCache&) = delete;
+
+    ~AsyncCache()
+    {
+        state_->clear();
+    }
+
+    ///
+    /// Returns the cached value for `key`, loading it if necessary.
+    ///
+    Future<std::shared_ptr<const V>> get(const K& key)
+    {
+        return SharedFuture<V>{ state_->get(key) }.get_shared();
+    }
+
+    ///
+    /// Removes `key` from the cache, the next `get` loads it again.
+    ///
+    void invalidate(const K& key)
+    {
+        state_->invalidate(key);
+    }
+
+    ///
+    /// Removes all entries from the cache.
+    ///
+    void clear()
+    {
+        state_->clear();
+    }
+
+    ///
+    /// Number of cached entries, including the ones still being loaded.
+    ///
+    std::size_t size() const
+    {
+        return state_->size();
+    }
+
+  private:
+    const std::shared_ptr<detail::AsyncCacheState<K, V, Hash>> state_;
+};
+} // namespace asyncly
@@ -0,0 +1,221 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "asyncly/future/Future.h"
+
+namespace asyncly {
+
+///
+/// AsyncMutex provides mutual exclusion for critical sections that
+/// span asynchronous operations, without blocking threads and without
+/// tying the callers to a single executor like a `Strand` does.
+/// `lock` returns a `Future` for a `Guard`, which can be used in a
+/// continuation chain or with `co_await`. Locking an unlocked mutex
+/// takes a single compare-and-swap. Contended callers are queued in
+/// FIFO order and resume on the executor that attached their
+/// continuation once the lock is handed to them.
+///
+/// The mutex must outlive all `Guards` and pending `lock` calls.
+///
+/// Example usage:
+/// \snippet AsyncMutexTest.cpp AsyncMutex Coroutine
+///
+class AsyncMutex {
+    struct Waiter;
+
+  public:
+    class Guard {
+      public:
+        Guard() = default;
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        Guard(Guard&& other) noexcept
+            : mutex_{ std::exchange(other.mutex_, nullptr) }
+        {
+        }
+
+        Guard& operator=(Guard&& other) noexcept
+        {
+            if (this != &other) {
+                unlock();
+                mutex_ = std::exchange(other.mutex_, nullptr);
+            }
+            return *this;
+        }
+
+        ~Guard()
+        {
+            unlock();
+        }
+
+        /// unlocks the mutex before the `Guard` is destroyed
+        void unlock()
+        {
+            if (auto mutex = std::exchange(mutex_, nullptr)) {
+                mutex->unlock();
+            }
+        }
+
+        /// \return whether the `Guard` still holds the lock
+        explicit operator bool() const
+        {
+            return mutex_ != nullptr;
+        }
+
+      private:
+        friend class AsyncMutex;
+        explicit Guard(AsyncMutex* mutex)
+            : mutex_{ mutex }
+        {
+        }
+
+        AsyncMutex* mutex_ = nullptr;
+    };
+
+    AsyncMutex() = default;
+    AsyncMutex(const AsyncMutex&) = delete;
+    AsyncMutex& operator=(const AsyncMutex&) = delete;
+
+    ~AsyncMutex()
+    {
+        // only cancelled waiters can be left over here
+        delete_waiters(waiters_);
+        auto state = state_.load(std::memory_order_acquire);
+        if (state != kUnlocked && state != kLockedNoWaiters) {
+            delete_waiters(reinterpret_cast<Waiter*>(state));
+        }
+    }
+
+    ///
+    /// \return a `Future` that is resolved with a `Guard` once the
+    /// lock has been acquired. Cancelling it gives up the place in the
+    /// queue.
+    ///
+    Future<Guard> lock()
+    {
+        if (try_acquire()) {
+            return make_ready_future(Guard{ this });
+        }
+
+        auto lazy = make_lazy_future<Guard>();
+        auto waiter = new Waiter{ std::get<1>(lazy), nullptr };
+        auto state = state_.load(std::memory_order_relaxed);
+        while (true) {
+            if (state == kUnlocked) {
+                if (state_.compare_exchange_weak(
+                        state, kLockedNoWaiters, std::memory_order_acquire)) {
+                    delete waiter;
+                    return make_ready_future(Guard{ this });
+                }
+                continue;
+            }
+
+            waiter->next = state == kLockedNoWaiters ? nullptr : reinterpret_cast<Waiter*>(state);
+            if (state_.compare_exchange_weak(
+                    state, reinterpret_cast<std::uintptr_t>(waiter), std::memory_order_release)) {
+                return std::get<0>(std::move(lazy));
+            }
+        }
+    }
+
+    /// \return a `Guard` if the mutex could be locked right away
+    std::optional<Guard> try_lock()
+    {
+        if (try_acquire()) {
+            return Guard{ this };
+        }
+        return std::nullopt;
+    }
+
+  private:
+    struct Waiter {
+        Promise<Guard> promise;
+        Waiter* next;
+    };
+
+    // State values besides these two are the head of a stack of waiters pushed by lock(), most
+    // recent first. The lock holder moves it to `waiters_` in FIFO order when it needs the next
+    // waiter, so the stack is the only part shared between threads.
+    static constexpr std::uintptr_t kUnlocked = 1;
+    static constexpr std::uintptr_t kLockedNoWaiters = 0;
+
+    bool try_acquire()
+    {
+        auto expected = kUnlocked;
+        return state_.compare_exchange_strong(
+            expected, kLockedNoWaiters, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+        while (true) {
+            if (waiters_ == nullptr) {
+                auto expected = kLockedNoWaiters;
+                if (state_.compare_exchange_strong(
+                        expected,
+                        kUnlocked,
+                        std::memory_order_release,
+                        std::memory_order_relaxed)) {
+                    return;
+                }
+
+                auto stack = reinterpret_cast<Waiter*>(
+                    state_.exchange(kLockedNoWaiters, std::memory_order_acquire));
+                while (stack != nullptr) {
+                    auto next = stack->next;
+                    stack->next = waiters_;
+                    waiters_ = stack;
+                    stack = next;
+                }
+            }
+
+            auto waiter = waiters_;
+            waiters_ = waiter->next;
+            auto promise = std::move(waiter->promise);
+            delete waiter;
+
+            if (promise.is_cancelled()) {
+                continue;
+            }
+            // the lock is handed over without being unlocked in between; should the waiter be
+            // cancelled concurrently, the Guard is dropped, which unlocks again
+            promise.set_value(Guard{ this });
+            return;
+        }
+    }
+
+    static void delete_waiters(Waiter* waiter)
+    {
+        while (waiter != nullptr) {
+            delete std::exchange(waiter, waiter->next);
+        }
+    }
+
+    std::atomic<std::uintptr_t> state_{ kUnlocked };
+    // only accessed by the current lock holder
+    Waiter* waiters_ = nullptr;
+};
+} // namespace asyncly
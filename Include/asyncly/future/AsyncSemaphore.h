@@ -0,0 +1,222 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "asyncly/future/Future.h"
+
+namespace asyncly {
+
+///
+/// AsyncSemaphore limits the number of concurrent operations without
+/// blocking threads. `acquire` returns a `Future` for a `Permit` that
+/// is resolved right away if one is available and otherwise once it
+/// is the turn of the caller, waiters being served in FIFO order.
+/// Continuations run on the executor that attached them like with any
+/// other `Future`, so every waiter resumes on its own executor, and
+/// `acquire` can be used with `co_await` as well.
+///
+/// Permits are returned to the semaphore when they are destroyed or
+/// `release`d, they may outlive the semaphore.
+///
+/// Example usage:
+/// \snippet AsyncSemaphoreTest.cpp AsyncSemaphore Acquire
+///
+class AsyncSemaphore {
+    struct State;
+
+  public:
+    class Permit {
+      public:
+        Permit() = default;
+        Permit(const Permit&) = delete;
+        Permit& operator=(const Permit&) = delete;
+        Permit(Permit&& other) noexcept = default;
+        Permit& operator=(Permit&& other) noexcept;
+        ~Permit();
+
+        /// returns the permit to the semaphore before the `Permit` is destroyed
+        void release();
+
+        /// \return whether the `Permit` still holds a permit of the semaphore
+        explicit operator bool() const
+        {
+            return state_ != nullptr;
+        }
+
+      private:
+        friend class AsyncSemaphore;
+        explicit Permit(std::shared_ptr<State> state)
+            : state_{ std::move(state) }
+        {
+        }
+
+        std::shared_ptr<State> state_;
+    };
+
+    explicit AsyncSemaphore(std::size_t permits)
+        : state_{ std::make_shared<State>(permits) }
+    {
+    }
+
+    AsyncSemaphore(const AsyncSemaphore&) = delete;
+    AsyncSemaphore& operator=(const AsyncSemaphore&) = delete;
+
+    ///
+    /// \return a `Future` that is resolved with a `Permit` once one is
+    /// available. Cancelling it gives up the place in the queue.
+    ///
+    Future<Permit> acquire()
+    {
+        std::unique_lock<std::mutex> lock{ state_->mutex };
+        if (state_->available > 0 && state_->waiters.empty()) {
+            state_->available--;
+            lock.unlock();
+            return make_ready_future(Permit{ state_ });
+        }
+
+        auto lazy = make_lazy_future<Permit>();
+        state_->waiters.push_back(std::get<1>(lazy));
+        return std::get<0>(std::move(lazy));
+    }
+
+    /// \return a `Permit` if one is available right away, without queueing
+    std::optional<Permit> try_acquire()
+    {
+        std::lock_guard<std::mutex> lock{ state_->mutex };
+        if (state_->available == 0 || !state_->waiters.empty()) {
+            return std::nullopt;
+        }
+        state_->available--;
+        return Permit{ state_ };
+    }
+
+    /// \return the number of permits that are currently not handed out
+    std::size_t available() const
+    {
+        std::lock_guard<std::mutex> lock{ state_->mutex };
+        return state_->available;
+    }
+
+  private:
+    struct State {
+        explicit State(std::size_t permits)
+            : available{ permits }
+        {
+        }
+
+        std::mutex mutex;
+        std::size_t available;
+        std::deque<Promise<Permit>> waiters;
+    };
+
+    // Hands the permit directly to the first waiter instead of making it available, so a waiter
+    // cannot be overtaken by a later acquire().
+    static void release_permit(const std::shared_ptr<State>& state)
+    {
+        while (true) {
+            std::optional<Promise<Permit>> waiter;
+            {
+                std::lock_guard<std::mutex> lock{ state->mutex };
+                if (state->waiters.empty()) {
+                    state->available++;
+                    return;
+                }
+                waiter.emplace(std::move(state->waiters.front()));
+                state->waiters.pop_front();
+            }
+
+            if (waiter->is_cancelled()) {
+                continue;
+            }
+            // should the waiter be cancelled concurrently, the permit is dropped and thereby
+            // released again
+            waiter->set_value(Permit{ state });
+            return;
+        }
+    }
+
+    const std::shared_ptr<State> state_;
+};
+
+inline AsyncSemaphore::Permit& AsyncSemaphore::Permit::operator=(Permit&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        state_ = std::move(other.state_);
+    }
+    return *this;
+}
+
+inline AsyncSemaphore::Permit::~Permit()
+{
+    release();
+}
+
+inline void AsyncSemaphore::Permit::release()
+{
+    if (auto state = std::move(state_)) {
+        AsyncSemaphore::release_permit(state);
+    }
+}
+
+///
+/// with_concurrency_limit wraps the `Future` returning function `f`
+/// so that at most `n` of the `Futures` returned by it are pending at
+/// any time. Calls beyond the limit are queued in FIFO order and `f`
+/// is only called once an earlier `Future` has been resolved or
+/// rejected. All copies of the returned function share the limit.
+///
+/// Example usage:
+/// \snippet AsyncSemaphoreTest.cpp AsyncSemaphore Concurrency Limit
+///
+template <typename F> auto with_concurrency_limit(std::size_t n, F f)
+{
+    return [semaphore = std::make_shared<AsyncSemaphore>(n),
+            f = std::make_shared<F>(std::move(f))](auto&&... args) {
+        using FutureT = std::invoke_result_t<F&, std::decay_t<decltype(args)>...>;
+        using T = typename FutureT::value_type;
+
+        return semaphore->acquire().then(
+            [f, args = std::make_tuple(std::forward<decltype(args)>(args)...)](
+                AsyncSemaphore::Permit permit) mutable {
+                auto heldPermit = std::make_shared<AsyncSemaphore::Permit>(std::move(permit));
+                auto future = std::apply(*f, std::move(args));
+                future.catch_and_forward_error(
+                    [heldPermit](std::exception_ptr) { heldPermit->release(); });
+                if constexpr (std::is_void_v<T>) {
+                    return future.then([heldPermit]() { heldPermit->release(); });
+                } else {
+                    return future.then([heldPermit](T value) {
+                        heldPermit->release();
+                        return value;
+                    });
+                }
+            });
+    };
+}
+} // namespace asyncly
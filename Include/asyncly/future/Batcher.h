@@ -0,0 +1,266 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "asyncly/ExecutorTypes.h"
+#include "asyncly/executor/CurrentExecutor.h"
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/future/Future.h"
+#include "asyncly/task/Cancelable.h"
+
+namespace asyncly {
+
+struct BatcherOptions {
+    /// number of requests after which a batch is dispatched right away
+    std::size_t maxBatchSize = 64;
+    /// time after the first request of a batch after which it is dispatched at the latest
+    clock_type::duration maxDelay = std::chrono::milliseconds(1);
+};
+
+namespace detail {
+
+/// State behind a Batcher, shared with the deadline timer and the continuations of dispatched
+/// batches. `batchId_` identifies the batch currently being collected, so a deadline timer that
+/// fires after its batch has already been dispatched because it was full is ignored.
+template <typename Req, typename Resp>
+class BatcherState : public std::enable_shared_from_this<BatcherState<Req, Resp>> {
+  public:
+    using batch_function_t = std::function<Future<std::vector<Resp>>(std::vector<Req>)>;
+
+    BatcherState(batch_function_t f, BatcherOptions options, IExecutorPtr executor)
+        : f_{ std::move(f) }
+        , options_{ options }
+        , executor_{ std::move(executor) }
+    {
+    }
+
+    Future<Resp> submit(Req request)
+    {
+        auto lazy = make_lazy_future<Resp>();
+        std::optional<Batch> full;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            batch_.requests.push_back(std::move(request));
+            batch_.promises.push_back(std::get<1>(lazy));
+            if (batch_.requests.size() >= options_.maxBatchSize) {
+                full.emplace(take_locked());
+            } else if (batch_.requests.size() == 1) {
+                timer_ = executor_->post_after(
+                    options_.maxDelay, [weak = this->weak_from_this(), id = batchId_]() {
+                        if (auto self = weak.lock()) {
+                            self->deadline(id);
+                        }
+                    });
+            }
+        }
+        if (full) {
+            dispatch(std::move(*full));
+        }
+        return std::get<0>(lazy);
+    }
+
+    void flush()
+    {
+        std::optional<Batch> batch;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            if (batch_.requests.empty()) {
+                return;
+            }
+            batch.emplace(take_locked());
+        }
+        dispatch(std::move(*batch));
+    }
+
+  private:
+    struct Batch {
+        std::vector<Req> requests;
+        std::vector<Promise<Resp>> promises;
+        std::shared_ptr<Cancelable> timer;
+    };
+
+    void deadline(std::uint64_t id)
+    {
+        std::optional<Batch> batch;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            if (id != batchId_ || batch_.requests.empty()) {
+                return;
+            }
+            batch.emplace(take_locked());
+        }
+        dispatch(std::move(*batch));
+    }
+
+    Batch take_locked()
+    {
+        Batch batch = std::move(batch_);
+        batch.timer = std::move(timer_);
+        batch_ = {};
+        batch_.requests.reserve(options_.maxBatchSize);
+        batch_.promises.reserve(options_.maxBatchSize);
+        batchId_++;
+        return batch;
+    }
+
+    void dispatch(Batch batch)
+    {
+        if (batch.timer) {
+            batch.timer->cancel();
+        }
+
+        // requests whose callers are no longer interested are not sent at all
+        std::vector<Req> requests;
+        std::vector<Promise<Resp>> promises;
+        requests.reserve(batch.requests.size());
+        promises.reserve(batch.promises.size());
+        for (std::size_t i = 0; i < batch.requests.size(); i++) {
+            if (!batch.promises[i].is_cancelled()) {
+                requests.push_back(std::move(batch.requests[i]));
+                promises.push_back(std::move(batch.promises[i]));
+            }
+        }
+        if (requests.empty()) {
+            return;
+        }
+
+        std::optional<Future<std::vector<Resp>>> future;
+        try {
+            future.emplace(f_(std::move(requests)));
+        } catch (...) {
+            reject(promises, std::current_exception());
+            return;
+        }
+
+        auto shared = std::make_shared<std::vector<Promise<Resp>>>(std::move(promises));
+        future
+            ->then([shared](std::vector<Resp> responses) {
+                if (responses.size() != shared->size()) {
+                    reject(
+                        *shared,
+                        std::make_exception_ptr(std::runtime_error(
+                            "batch function returned a different number of responses")));
+                    return;
+                }
+                for (std::size_t i = 0; i < responses.size(); i++) {
+                    (*shared)[i].set_value(std::move(responses[i]));
+                }
+            })
+            .catch_error([shared](std::exception_ptr e) { reject(*shared, e); });
+    }
+
+    static void reject(std::vector<Promise<Resp>>& promises, std::exception_ptr e)
+    {
+        for (auto& promise : promises) {
+            promise.set_exception(e);
+        }
+    }
+
+    const batch_function_t f_;
+    const BatcherOptions options_;
+    const IExecutorPtr executor_;
+
+    std::mutex mutex_;
+    Batch batch_;
+    std::shared_ptr<Cancelable> timer_;
+    std::uint64_t batchId_ = 0;
+};
+} // namespace detail
+
+///
+/// Batcher coalesces individual requests into batches for a function
+/// that handles many requests at once. Callers `submit` a single
+/// request and get a `Future` for its response. A batch is dispatched
+/// once it holds `options.maxBatchSize` requests or
+/// `options.maxDelay` after its first request, whichever comes first.
+///
+/// The batch function takes the requests of a batch and returns a
+/// `Future` for their responses in the same order. Each response is
+/// forwarded to the caller that submitted the matching request. If
+/// the batch function fails, all requests of the batch are rejected
+/// with the same error. Requests whose `Future` has been cancelled
+/// before their batch is dispatched are left out of it.
+///
+/// A full batch is dispatched from within the `submit` call that
+/// filled it, batches that reached their deadline from the executor
+/// that was current when the Batcher was created. All member
+/// functions are thread-safe. Pending requests are dispatched when
+/// the Batcher is destroyed.
+///
+/// Example usage:
+/// \snippet BatcherTest.cpp Batcher Submit
+///
+template <typename Req, typename Resp> class Batcher {
+  public:
+    using batch_function_t = typename detail::BatcherState<Req, Resp>::batch_function_t;
+
+    ///
+    /// Must be called from within an executor task, which is where
+    /// the deadline timers are posted to.
+    ///
+    explicit Batcher(batch_function_t f, BatcherOptions options = {})
+        : state_{ std::make_shared<detail::BatcherState<Req, Resp>>(
+            std::move(f), options, this_thread::get_current_executor()) }
+    {
+        if (options.maxBatchSize == 0) {
+            throw std::invalid_argument("Batcher needs a batch size of at least one");
+        }
+    }
+
+    Batcher(const Batcher&) = delete;
+    Batcher& operator=(const Batcher&) = delete;
+
+    ~Batcher()
+    {
+        state_->flush();
+    }
+
+    ///
+    /// Adds `request` to the current batch.
+    ///
+    Future<Resp> submit(Req request)
+    {
+        return state_->submit(std::move(request));
+    }
+
+    ///
+    /// Dispatches the current batch without waiting for it to fill up
+    /// or reach its deadline.
+    ///
+    void flush()
+    {
+        state_->flush();
+    }
+
+  private:
+    const std::shared_ptr<detail::BatcherState<Req, Resp>> state_;
+};
+} // namespace asyncly
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2019 LogMeIn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <exception>
+
+namespace asyncly {
+
+/// Cancelled is the error a future is rejected with when it is cancelled before being resolved.
+struct Cancelled : public std::exception {
+    const char* what() const noexcept override
+    {
+        return "Cancelled";
+    }
+};
+
+} // namespace asyncly
@@ -0,0 +1,306 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "asyncly/future/Future.h"
+
+namespace asyncly {
+
+/// ChannelClosed is the error sends to and receives from a closed and drained Channel fail with.
+struct ChannelClosed : public std::exception {
+    const char* what() const noexcept override
+    {
+        return "ChannelClosed";
+    }
+};
+
+///
+/// Channel is a bounded multi-producer multi-consumer queue for
+/// handing values from one asynchronous stage to another. Values are
+/// buffered in a ring buffer of fixed capacity, so the channel itself
+/// does not allocate per value. Once the buffer is full, the `Futures`
+/// returned by `send` are only resolved when a receiver made room,
+/// which allows producers to slow down to the pace of the consumers. A
+/// capacity of `0` makes every send wait for a receiver.
+///
+/// Receivers that can handle several values at once should use
+/// `receive_batch`, which wakes them up once for everything that is
+/// buffered instead of once per value.
+///
+/// The channel must outlive all pending sends and receives. Values are
+/// delivered in the order in which they were sent.
+///
+/// Example usage:
+/// \snippet ChannelTest.cpp Channel Pipeline
+///
+template <typename T> class Channel {
+  public:
+    explicit Channel(std::size_t capacity)
+        : buffer_(capacity)
+    {
+    }
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    ~Channel()
+    {
+        close();
+        for (auto& sender : senders_) {
+            sender.promise.set_exception(ChannelClosed{});
+        }
+    }
+
+    ///
+    /// \return a `Future` that is resolved once `value` is buffered or
+    /// handed to a receiver, or rejected with `ChannelClosed` if the
+    /// channel has been closed
+    ///
+    Future<void> send(T value)
+    {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        while (true) {
+            if (closed_) {
+                return make_exceptional_future<void>(ChannelClosed{});
+            }
+
+            // receivers only wait while the buffer is empty, so the value can skip it
+            auto receiver = pop_receiver();
+            if (!receiver) {
+                break;
+            }
+            lock.unlock();
+            if (receiver->deliver(value)) {
+                return make_ready_future();
+            }
+            // the receiver has been cancelled after it was taken from the queue, try the next one
+            lock.lock();
+        }
+
+        if (size_ < buffer_.size()) {
+            push(std::move(value));
+            return make_ready_future();
+        }
+
+        auto lazy = make_lazy_future<void>();
+        senders_.push_back({ std::move(value), std::get<1>(lazy) });
+        return std::get<0>(std::move(lazy));
+    }
+
+    ///
+    /// \return a `Future` containing the next value, rejected with
+    /// `ChannelClosed` once the channel has been closed and everything
+    /// sent before has been received
+    ///
+    Future<T> receive()
+    {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        auto values = take(1);
+        if (!values.items.empty()) {
+            lock.unlock();
+            values.resolve_senders();
+            return make_ready_future(std::move(values.items.front()));
+        }
+        if (closed_) {
+            return make_exceptional_future<T>(ChannelClosed{});
+        }
+
+        auto lazy = make_lazy_future<T>();
+        receivers_.push_back(Receiver{ std::get<1>(lazy), std::nullopt });
+        return std::get<0>(std::move(lazy));
+    }
+
+    ///
+    /// \return a `Future` containing between `1` and `maxValues`
+    /// values, resolved as soon as at least one value is available,
+    /// see `receive`
+    ///
+    Future<std::vector<T>> receive_batch(std::size_t maxValues)
+    {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        auto values = take(std::max<std::size_t>(maxValues, 1));
+        if (!values.items.empty()) {
+            lock.unlock();
+            values.resolve_senders();
+            return make_ready_future(std::move(values.items));
+        }
+        if (closed_) {
+            return make_exceptional_future<std::vector<T>>(ChannelClosed{});
+        }
+
+        auto lazy = make_lazy_future<std::vector<T>>();
+        receivers_.push_back(Receiver{ std::nullopt, std::get<1>(lazy) });
+        return std::get<0>(std::move(lazy));
+    }
+
+    ///
+    /// closes the channel: further sends are rejected, values sent
+    /// before can still be received. Pending receives are rejected
+    /// with `ChannelClosed` as there is nothing left to receive.
+    ///
+    void close()
+    {
+        std::deque<Receiver> receivers;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            closed_ = true;
+            receivers.swap(receivers_);
+        }
+        for (auto& receiver : receivers) {
+            receiver.reject(std::make_exception_ptr(ChannelClosed{}));
+        }
+    }
+
+    /// \return the number of values that are buffered or waiting to be sent
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        return size_ + senders_.size();
+    }
+
+  private:
+    struct Sender {
+        T value;
+        Promise<void> promise;
+    };
+
+    struct Receiver {
+        std::optional<Promise<T>> single;
+        std::optional<Promise<std::vector<T>>> batch;
+
+        bool is_cancelled() const
+        {
+            return single ? single->is_cancelled() : batch->is_cancelled();
+        }
+
+        // Returns false if the receiver has been cancelled in the meantime. The promise drops the
+        // value without moving from it then, and a promise that got its value can no longer be
+        // cancelled, so the value is either received or still in `value`.
+        bool deliver(T& value)
+        {
+            if (single) {
+                single->set_value(std::move(value));
+                return !single->is_cancelled();
+            }
+
+            auto values = std::vector<T>{};
+            values.push_back(std::move(value));
+            batch->set_value(std::move(values));
+            if (batch->is_cancelled()) {
+                value = std::move(values.front());
+                return false;
+            }
+            return true;
+        }
+
+        void reject(std::exception_ptr error)
+        {
+            if (single) {
+                single->set_exception(error);
+            } else {
+                batch->set_exception(error);
+            }
+        }
+    };
+
+    // Values taken out of the channel together with the senders that got room in the buffer by
+    // that, whose Futures are resolved once the lock has been released.
+    struct Taken {
+        std::vector<T> items;
+        std::vector<Promise<void>> senders;
+
+        void resolve_senders()
+        {
+            for (auto& sender : senders) {
+                sender.set_value();
+            }
+        }
+    };
+
+    std::optional<Receiver> pop_receiver()
+    {
+        while (!receivers_.empty()) {
+            auto receiver = std::move(receivers_.front());
+            receivers_.pop_front();
+            // receivers that gave up are dropped instead of being handed a value
+            if (!receiver.is_cancelled()) {
+                return receiver;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void push(T value)
+    {
+        buffer_[(head_ + size_) % buffer_.size()].emplace(std::move(value));
+        size_++;
+    }
+
+    Taken take(std::size_t maxValues)
+    {
+        Taken taken;
+        while (taken.items.size() < maxValues && size_ > 0) {
+            auto& slot = buffer_[head_];
+            taken.items.push_back(std::move(*slot));
+            slot.reset();
+            head_ = (head_ + 1) % buffer_.size();
+            size_--;
+        }
+
+        // Waiting senders come after everything buffered, so their values are handed over
+        // directly only once the buffer is empty, the remaining ones refill the buffer.
+        while (!senders_.empty()) {
+            const auto direct = size_ == 0 && taken.items.size() < maxValues;
+            if (!direct && size_ == buffer_.size()) {
+                break;
+            }
+
+            auto sender = std::move(senders_.front());
+            senders_.pop_front();
+            if (sender.promise.is_cancelled()) {
+                continue;
+            }
+            if (direct) {
+                taken.items.push_back(std::move(sender.value));
+            } else {
+                push(std::move(sender.value));
+            }
+            taken.senders.push_back(std::move(sender.promise));
+        }
+        return taken;
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::optional<T>> buffer_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+    std::deque<Sender> senders_;
+    std::deque<Receiver> receivers_;
+    bool closed_ = false;
+};
+} // namespace asyncly
@@ -32,6 +32,7 @@
 #include "asyncly/future/detail/Coroutine.h"
 #include "asyncly/future/detail/Future.h"
 #include "asyncly/future/detail/FutureImpl.h"
+#include "asyncly/task/CancellationToken.h"
 
 ///
 /// \file
@@ -242,6 +243,38 @@ template <typename T> class Future {
         return *this;
     }
 
+    ///
+    /// `cancel` signals that the value of a pending `Future` is no
+    /// longer needed. The `Future` is rejected with
+    /// `asyncly::Cancelled`, continuations that have not started yet
+    /// are skipped and the cancellation is propagated to the
+    /// `Futures` and operations the value would have been derived
+    /// from, which can react to it by means of
+    /// `Promise::on_cancel`. Calling `cancel` on a `Future` that is
+    /// already resolved or rejected has no effect.
+    ///
+    void cancel()
+    {
+        futureImpl_->cancel();
+    }
+
+    ///
+    /// `with_cancellation` ties the `Future` to a
+    /// `CancellationToken`: once the token is cancelled, the `Future`
+    /// is cancelled just as if `cancel` had been called on it. The
+    /// token is inherited by all `Futures` created by `then`, so a
+    /// single `CancellationSource` can tear down a whole chain or
+    /// fan-out tree at once.
+    ///
+    /// Example usage:
+    /// \snippet CancellationTokenTest.cpp CancellationToken FanOut
+    ///
+    Future<T>& with_cancellation(const CancellationToken& token)
+    {
+        futureImpl_->set_cancellation_token(token);
+        return *this;
+    }
+
   public:
     Future(const std::shared_ptr<detail::FutureImpl<T>>& futureImpl)
         : futureImpl_{ futureImpl }
@@ -295,6 +328,17 @@ template <> class Future<void> {
         return *this;
     }
 
+    void cancel()
+    {
+        futureImpl_->cancel();
+    }
+
+    Future<void>& with_cancellation(const CancellationToken& token)
+    {
+        futureImpl_->set_cancellation_token(token);
+        return *this;
+    }
+
   public:
     Future(const std::shared_ptr<detail::FutureImpl<void>>& futureImpl)
         : futureImpl_{ futureImpl }
@@ -360,6 +404,30 @@ template <typename T> class Promise {
         return { promiseImpl_->get_future() };
     }
 
+    ///
+    /// `on_cancel` registers a handler that is called once the
+    /// corresponding `Future` is cancelled, allowing the producer to
+    /// abort pending work, e.g. by cancelling timers it
+    /// scheduled. The handler is called immediately if the `Future`
+    /// has already been cancelled, and released without being called
+    /// once the `Promise` is fulfilled. Registering a new handler
+    /// replaces the previous one.
+    ///
+    template <typename F> void on_cancel(F&& handler)
+    {
+        promiseImpl_->on_cancel(std::forward<F>(handler));
+    }
+
+    ///
+    /// `is_cancelled` returns true once the corresponding `Future`
+    /// has been cancelled. Values passed to `set_value` or
+    /// `set_exception` afterwards are discarded.
+    ///
+    bool is_cancelled() const
+    {
+        return promiseImpl_->is_cancelled();
+    }
+
     Promise()
         : promiseImpl_{ std::get<1>(detail::make_lazy_future_impl<T>()) }
     {
@@ -394,6 +462,16 @@ template <> class Promise<void> {
         return { promiseImpl_->get_future() };
     }
 
+    template <typename F> void on_cancel(F&& handler)
+    {
+        promiseImpl_->on_cancel(std::forward<F>(handler));
+    }
+
+    bool is_cancelled() const
+    {
+        return promiseImpl_->is_cancelled();
+    }
+
     Promise()
         : promiseImpl_{ std::get<1>(detail::make_lazy_future_impl<void>()) }
     {
@@ -497,7 +575,8 @@ Future<T> make_future_from_impl(const std::shared_ptr<detail::FutureImpl<T>>& fu
 /// \param args arguments that will be passed to the functor
 ///
 /// \result a asyncly::Future<result_t> that will hold the result of the
-/// functor call after completion
+/// functor call after completion. Cancelling it before the functor
+/// has been started prevents the functor from being called.
 ///
 
 template <class Fn, class... Args>
@@ -511,6 +590,9 @@ auto async(IExecutorPtr executor, Fn&& function, Args&&... args) noexcept
                     fn = std::forward<Fn>(function),
                     tuple = std::tuple<std::remove_reference_t<Args>...>{
                         std::forward<Args>(args)... }]() mutable {
+        if (p->is_cancelled()) {
+            return;
+        }
         try {
             if constexpr (std::is_void_v<result_t>) {
                 std::apply(std::move(fn), std::move(tuple));
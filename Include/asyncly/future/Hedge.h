@@ -0,0 +1,356 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "asyncly/ExecutorTypes.h"
+#include "asyncly/executor/CurrentExecutor.h"
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/future/Future.h"
+#include "asyncly/task/Cancelable.h"
+
+namespace asyncly {
+
+///
+/// HedgeLatencyTracker records the latencies of successful hedged
+/// calls and derives the hedging delay from a percentile of the most
+/// recent ones, so that only the slowest calls get a second attempt.
+/// Until `minSamples` latencies have been recorded, `initialDelay` is
+/// used. All member functions are thread-safe.
+///
+class HedgeLatencyTracker {
+  public:
+    HedgeLatencyTracker(
+        double percentile,
+        clock_type::duration initialDelay,
+        std::size_t windowSize = 256,
+        std::size_t minSamples = 16)
+        : percentile_{ std::clamp(percentile, 0.0, 1.0) }
+        , delay_{ initialDelay }
+        , windowSize_{ windowSize }
+        , minSamples_{ std::min(minSamples, windowSize) }
+    {
+        if (windowSize == 0) {
+            throw std::invalid_argument("HedgeLatencyTracker needs a window of at least one");
+        }
+        samples_.reserve(windowSize);
+    }
+
+    void record(clock_type::duration latency)
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        if (samples_.size() < windowSize_) {
+            samples_.push_back(latency);
+        } else {
+            samples_[next_] = latency;
+        }
+        next_ = (next_ + 1) % windowSize_;
+        // the percentile is only recomputed every few samples, it moves slowly anyway
+        sinceUpdate_++;
+        if (samples_.size() == minSamples_
+            || (samples_.size() > minSamples_ && sinceUpdate_ >= updateInterval())) {
+            sinceUpdate_ = 0;
+            update_locked();
+        }
+    }
+
+    clock_type::duration delay() const
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        return delay_;
+    }
+
+  private:
+    std::size_t updateInterval() const
+    {
+        return std::max<std::size_t>(1, windowSize_ / 16);
+    }
+
+    void update_locked()
+    {
+        sorted_ = samples_;
+        const auto index = static_cast<std::size_t>(
+            percentile_ * static_cast<double>(sorted_.size() - 1) + 0.5);
+        std::nth_element(sorted_.begin(), sorted_.begin() + index, sorted_.end());
+        delay_ = sorted_[index];
+    }
+
+    const double percentile_;
+    clock_type::duration delay_;
+    const std::size_t windowSize_;
+    const std::size_t minSamples_;
+
+    mutable std::mutex mutex_;
+    std::vector<clock_type::duration> samples_;
+    std::vector<clock_type::duration> sorted_;
+    std::size_t next_ = 0;
+    std::size_t sinceUpdate_ = 0;
+};
+
+namespace detail {
+
+// Shared by all attempts of one hedge() call. At most one timer is pending at any time, it starts
+// the next attempt. Attempts are tracked through weak pointers so that the losers can be
+// cancelled once the result is settled.
+template <typename T, typename F>
+class hedge_state : public std::enable_shared_from_this<hedge_state<T, F>> {
+  public:
+    hedge_state(
+        clock_type::duration delay,
+        std::size_t maxAttempts,
+        F f,
+        Promise<T> promise,
+        IExecutorPtr executor,
+        std::shared_ptr<HedgeLatencyTracker> tracker)
+        : delay_{ delay }
+        , maxAttempts_{ std::max<std::size_t>(maxAttempts, 1) }
+        , f_{ std::move(f) }
+        , promise_{ std::move(promise) }
+        , executor_{ std::move(executor) }
+        , tracker_{ std::move(tracker) }
+    {
+    }
+
+    void start()
+    {
+        promise_.on_cancel([weakSelf = this->weak_from_this()]() {
+            if (auto self = weakSelf.lock()) {
+                self->settle();
+            }
+        });
+        attempt();
+    }
+
+  private:
+    void attempt()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            if (settled_ || promise_.is_cancelled() || started_ == maxAttempts_) {
+                return;
+            }
+            started_++;
+            if (started_ < maxAttempts_) {
+                timer_ = executor_->post_after(
+                    tracker_ ? tracker_->delay() : delay_,
+                    [self = this->shared_from_this()]() { self->attempt(); });
+            }
+        }
+
+        const auto start = executor_->now();
+        std::optional<Future<T>> future;
+        try {
+            future.emplace(f_());
+        } catch (...) {
+            failed(std::current_exception());
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock{ mutex_ };
+            if (settled_) {
+                lock.unlock();
+                future->cancel();
+                return;
+            }
+            attempts_.push_back(detail::get_future_impl(*future));
+        }
+
+        auto self = this->shared_from_this();
+        if constexpr (std::is_void_v<T>) {
+            future->then([self, start]() {
+                if (self->succeeded(start)) {
+                    self->promise_.set_value();
+                }
+            });
+        } else {
+            future->then([self, start](T value) {
+                if (self->succeeded(start)) {
+                    self->promise_.set_value(std::move(value));
+                }
+            });
+        }
+        future->catch_error([self](std::exception_ptr error) { self->failed(error); });
+    }
+
+    // returns whether this attempt is the winner that settles the result
+    bool succeeded(clock_type::time_point start)
+    {
+        if (!settle()) {
+            return false;
+        }
+        if (tracker_) {
+            tracker_->record(executor_->now() - start);
+        }
+        return true;
+    }
+
+    void failed(std::exception_ptr error)
+    {
+        bool retryNow = false;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            failed_++;
+            if (settled_ || failed_ < started_) {
+                return;
+            }
+            // every attempt started so far failed, waiting for the timer is pointless
+            retryNow = started_ < maxAttempts_;
+            if (!retryNow) {
+                settled_ = true;
+            }
+        }
+
+        if (retryNow) {
+            cancel_timer();
+            attempt();
+        } else {
+            promise_.set_exception(error);
+        }
+    }
+
+    // marks the result as settled and cancels the pending timer and all attempts, returns false
+    // if it already was
+    bool settle()
+    {
+        std::shared_ptr<Cancelable> timer;
+        std::vector<std::weak_ptr<FutureImpl<T>>> attempts;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            if (settled_) {
+                return false;
+            }
+            settled_ = true;
+            timer = std::move(timer_);
+            attempts.swap(attempts_);
+        }
+        if (timer) {
+            timer->cancel();
+        }
+        for (auto& weakAttempt : attempts) {
+            if (auto attempt = weakAttempt.lock()) {
+                attempt->cancel();
+            }
+        }
+        return true;
+    }
+
+    void cancel_timer()
+    {
+        std::shared_ptr<Cancelable> timer;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            timer = std::move(timer_);
+        }
+        if (timer) {
+            timer->cancel();
+        }
+    }
+
+    const clock_type::duration delay_;
+    const std::size_t maxAttempts_;
+    F f_;
+    Promise<T> promise_;
+    const IExecutorPtr executor_;
+    const std::shared_ptr<HedgeLatencyTracker> tracker_;
+
+    std::mutex mutex_;
+    bool settled_ = false;
+    std::size_t started_ = 0;
+    std::size_t failed_ = 0;
+    std::shared_ptr<Cancelable> timer_;
+    std::vector<std::weak_ptr<FutureImpl<T>>> attempts_;
+};
+
+template <typename T, typename F>
+Future<T> start_hedge(
+    clock_type::duration delay,
+    std::size_t maxAttempts,
+    F f,
+    std::shared_ptr<HedgeLatencyTracker> tracker)
+{
+    auto lazy = make_lazy_future<T>();
+    std::make_shared<hedge_state<T, F>>(
+        delay,
+        maxAttempts,
+        std::move(f),
+        std::get<1>(lazy),
+        this_thread::get_current_executor(),
+        std::move(tracker))
+        ->start();
+    return std::get<0>(std::move(lazy));
+}
+} // namespace detail
+
+///
+/// hedge calls the `Future` returning function `f` and, if it has
+/// not succeeded after `delay`, calls it again, up to `maxAttempts`
+/// calls in total. The result is resolved with the value of the first
+/// attempt that succeeds, all other attempts are cancelled at that
+/// point. It is rejected with the last error only once all attempts
+/// have failed; if all attempts started so far have failed, the next
+/// one is started right away instead of waiting for `delay`.
+///
+/// Attempts are started from timers posted to the current executor
+/// with `post_after`. There is a single shared state and at most one
+/// pending timer per call, which makes this cheaper than combining
+/// `add_timeout` and `when_any`. Cancelling the result cancels the
+/// pending timer and all running attempts.
+///
+/// Example usage:
+/// \snippet HedgeTest.cpp Hedge
+///
+template <typename F>
+auto hedge(clock_type::duration delay, std::size_t maxAttempts, F f)
+    -> Future<typename std::invoke_result_t<F&>::value_type>
+{
+    using T = typename std::invoke_result_t<F&>::value_type;
+    return detail::start_hedge<T>(delay, maxAttempts, std::move(f), nullptr);
+}
+
+///
+/// Like `hedge` above, but takes the delay from `tracker`, which is
+/// fed with the latency of every successful call.
+///
+/// Example usage:
+/// \snippet HedgeTest.cpp Hedge Adaptive
+///
+template <typename F>
+auto hedge(std::shared_ptr<HedgeLatencyTracker> tracker, std::size_t maxAttempts, F f)
+    -> Future<typename std::invoke_result_t<F&>::value_type>
+{
+    using T = typename std::invoke_result_t<F&>::value_type;
+    if (!tracker) {
+        throw std::invalid_argument("hedge needs a latency tracker");
+    }
+    return detail::start_hedge<T>(
+        clock_type::duration{}, maxAttempts, std::move(f), std::move(tracker));
+}
+} // namespace asyncly
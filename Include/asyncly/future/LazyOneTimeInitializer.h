@@ -18,7 +18,7 @@
 
 #pragma once
 
-#include "asyncly/future/Split.h"
+#include "asyncly/future/SharedFuture.h"
 #include "asyncly/future/detail/FutureTraits.h"
 
 #include <optional>
@@ -57,9 +57,7 @@ template <typename T> class LazyOneTimeInitializer {
             _future.emplace(_fn());
             _fn = {};
         }
-        auto pair = asyncly::split(std::move(*_future));
-        _future.emplace(std::move(std::get<0>(pair)));
-        return std::get<1>(pair);
+        return _future->get_future();
     }
 
     bool hasFuture() const
@@ -74,7 +72,7 @@ template <typename T> class LazyOneTimeInitializer {
   private:
     std::function<asyncly::Future<T>()> _fn;
 
-    std::optional<asyncly::Future<T>> _future;
+    std::optional<asyncly::SharedFuture<T>> _future;
 };
 
 /// Creates a LazyOneTimeInitializer given a function returning an asyncly::Future.
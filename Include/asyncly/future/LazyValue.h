@@ -20,17 +20,18 @@
 
 #include "asyncly/Future.h"
 #include "asyncly/future/Future.h"
+#include "asyncly/future/SharedFuture.h"
 
-#include <optional>
+#include <memory>
 #include <stdexcept>
-#include <tuple>
 
 namespace asyncly {
 
 template <typename ValueType> class LazyValue {
   public:
     LazyValue()
-        : _future(_promise.get_future())
+        : _state(std::make_shared<detail::SharedFutureState<ValueType>>())
+        , _sharedFuture(_state)
         , _hasValue(false)
     {
     }
@@ -43,27 +44,26 @@ template <typename ValueType> class LazyValue {
     ~LazyValue()
     {
         if (!_hasValue) {
-            _promise.set_exception(std::runtime_error("Could not be resolved. No value was set."));
+            _state->set_exception(std::make_exception_ptr(
+                std::runtime_error("Could not be resolved. No value was set.")));
         }
     }
 
     asyncly::Future<ValueType> get_future()
     {
-        auto [futureToReturn, futureToStore] = asyncly::split(std::move(*_future));
-        _future.emplace(futureToStore);
-        return futureToReturn;
+        return _sharedFuture.get_future();
     }
 
     void set_value(const ValueType& value)
     {
         _hasValue = true;
-        _promise.set_value(value);
+        _state->set_value(value);
     }
 
     void set_value(ValueType&& value)
     {
         _hasValue = true;
-        _promise.set_value(std::move(value));
+        _state->set_value(std::move(value));
     }
 
     bool has_value() const
@@ -74,12 +74,12 @@ template <typename ValueType> class LazyValue {
     template <typename E> void set_exception(E e)
     {
         _hasValue = true;
-        _promise.set_exception(e);
+        _state->set_exception(detail::to_exception_ptr(e));
     }
 
   private:
-    asyncly::Promise<ValueType> _promise;
-    std::optional<asyncly::Future<ValueType>> _future;
+    const std::shared_ptr<detail::SharedFutureState<ValueType>> _state;
+    const asyncly::SharedFuture<ValueType> _sharedFuture;
 
     bool _hasValue;
 };
@@ -87,7 +87,8 @@ template <typename ValueType> class LazyValue {
 template <> class LazyValue<void> {
   public:
     LazyValue()
-        : _future(_promise.get_future())
+        : _state(std::make_shared<detail::SharedFutureState<void>>())
+        , _sharedFuture(_state)
         , _hasValue(false)
     {
     }
@@ -100,21 +101,20 @@ template <> class LazyValue<void> {
     ~LazyValue()
     {
         if (!_hasValue) {
-            _promise.set_exception(std::runtime_error("Could not be resolved. No value was set."));
+            _state->set_exception(std::make_exception_ptr(
+                std::runtime_error("Could not be resolved. No value was set.")));
         }
     }
 
     asyncly::Future<void> get_future()
     {
-        auto [futureToReturn, futureToStore] = asyncly::split(std::move(*_future));
-        _future.emplace(futureToStore);
-        return futureToReturn;
+        return _sharedFuture.get_future();
     }
 
     void set_value()
     {
         _hasValue = true;
-        _promise.set_value();
+        _state->set_value();
     }
 
     bool has_value() const
@@ -125,12 +125,12 @@ template <> class LazyValue<void> {
     template <typename E> void set_exception(E e)
     {
         _hasValue = true;
-        _promise.set_exception(e);
+        _state->set_exception(detail::to_exception_ptr(e));
     }
 
   private:
-    asyncly::Promise<void> _promise;
-    std::optional<asyncly::Future<void>> _future;
+    const std::shared_ptr<detail::SharedFutureState<void>> _state;
+    const asyncly::SharedFuture<void> _sharedFuture;
 
     bool _hasValue;
 };
@@ -0,0 +1,245 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/future/Future.h"
+#include "asyncly/future/detail/Parallel.h"
+
+namespace asyncly {
+
+///
+/// ParallelOptions controls how `parallel_for`, `parallel_transform`
+/// and `parallel_reduce` split their input. The defaults fit
+/// CPU-bound work on a `ThreadPoolExecutor` with one thread per core.
+///
+struct ParallelOptions {
+    /// maximum number of tasks posted to the executor, `0` means one per hardware thread
+    std::size_t maxTasks = 0;
+    /// number of elements processed in one go, `0` derives it from the size of the input so
+    /// that every task gets a few chunks to balance uneven work
+    std::size_t grainSize = 0;
+};
+
+///
+/// parallel_for calls `f` for every element of the random access
+/// range `[begin, end)` on `executor`. The range is split into
+/// chunks that are claimed by a small number of tasks, so there is
+/// no per-element task or allocation.
+///
+/// `f` is called concurrently from all threads of the executor and
+/// must therefore be thread-safe. The range must stay valid until
+/// the returned `Future` is resolved or rejected, which only happens
+/// after the last call to `f` has returned. If `f` throws, no
+/// further chunks are started and the `Future` is rejected with the
+/// first exception. Cancelling the `Future` stops the processing of
+/// further chunks as well, and so does an exception thrown by
+/// `executor->post`, which rejects the `Future` instead of being
+/// thrown to the caller.
+///
+/// Example usage:
+/// \snippet ParallelTest.cpp Parallel Transform Reduce
+///
+template <typename I, typename F>
+Future<void> parallel_for(
+    const IExecutorPtr& executor, I begin, I end, F f, const ParallelOptions& options = {})
+{
+    static_assert(
+        std::random_access_iterator<I>, "parallel algorithms require random access iterators");
+
+    const auto size = static_cast<std::size_t>(std::distance(begin, end));
+    const auto chunking
+        = detail::make_parallel_chunking(size, options.maxTasks, options.grainSize);
+
+    return detail::run_parallel_loop<void>(
+        executor,
+        size,
+        chunking,
+        [begin, f = std::move(f)](std::size_t first, std::size_t last) {
+            using Difference = typename std::iterator_traits<I>::difference_type;
+            const auto chunkEnd = begin + static_cast<Difference>(last);
+            for (auto it = begin + static_cast<Difference>(first); it != chunkEnd; ++it) {
+                f(*it);
+            }
+        },
+        [](Promise<void>& promise) { promise.set_value(); });
+}
+
+///
+/// parallel_transform applies `f` to every element of the random
+/// access range `[begin, end)` on `executor`, see `parallel_for` for
+/// how the work is split and for the requirements on `f` and the
+/// range.
+///
+/// \return a `Future` containing the results in the order of the
+/// input
+///
+template <typename I, typename F>
+Future<std::vector<std::invoke_result_t<const F&, typename std::iterator_traits<I>::reference>>>
+parallel_transform(
+    const IExecutorPtr& executor, I begin, I end, F f, const ParallelOptions& options = {})
+{
+    static_assert(
+        std::random_access_iterator<I>, "parallel algorithms require random access iterators");
+
+    using R = std::invoke_result_t<const F&, typename std::iterator_traits<I>::reference>;
+    static_assert(!std::is_void_v<R>, "use parallel_for for functions returning void");
+    // default constructible results are written in place, everything else needs to be wrapped.
+    // So does bool, as neighbouring elements of std::vector<bool> cannot be written concurrently.
+    using Slot = std::conditional_t<
+        std::is_default_constructible_v<R> && !std::is_same_v<R, bool>,
+        R,
+        std::optional<R>>;
+
+    const auto size = static_cast<std::size_t>(std::distance(begin, end));
+    const auto chunking
+        = detail::make_parallel_chunking(size, options.maxTasks, options.grainSize);
+    auto results = std::make_shared<std::vector<Slot>>(size);
+
+    return detail::run_parallel_loop<std::vector<R>>(
+        executor,
+        size,
+        chunking,
+        [begin, f = std::move(f), results](std::size_t first, std::size_t last) {
+            using Difference = typename std::iterator_traits<I>::difference_type;
+            auto it = begin + static_cast<Difference>(first);
+            for (auto index = first; index < last; ++index, ++it) {
+                (*results)[index] = f(*it);
+            }
+        },
+        [results](Promise<std::vector<R>>& promise) {
+            if constexpr (std::is_same_v<Slot, R>) {
+                promise.set_value(std::move(*results));
+            } else {
+                auto values = std::vector<R>{};
+                values.reserve(results->size());
+                for (auto& slot : *results) {
+                    values.push_back(*std::move(slot));
+                }
+                promise.set_value(std::move(values));
+            }
+        });
+}
+
+///
+/// parallel_reduce combines all elements of the random access range
+/// `[begin, end)` and `init` using `op` on `executor`. Every chunk
+/// is reduced on its own, starting with its first element converted
+/// to `T`, and the partial results are combined with `init` in the
+/// order of the input once all chunks are done. `op` therefore has to
+/// be associative and callable with `(T, T)` as well as with `T` and
+/// an element of the range. See `parallel_for` for how the work is
+/// split and for the requirements on `op` and the range.
+///
+/// Example usage:
+/// \snippet ParallelTest.cpp Parallel Transform Reduce
+///
+template <typename I, typename T, typename BinaryOp>
+Future<T> parallel_reduce(
+    const IExecutorPtr& executor,
+    I begin,
+    I end,
+    T init,
+    BinaryOp op,
+    const ParallelOptions& options = {})
+{
+    static_assert(
+        std::random_access_iterator<I>, "parallel algorithms require random access iterators");
+
+    const auto size = static_cast<std::size_t>(std::distance(begin, end));
+    const auto chunking
+        = detail::make_parallel_chunking(size, options.maxTasks, options.grainSize);
+    auto partials = std::make_shared<std::vector<std::optional<T>>>(chunking.chunks);
+    auto sharedOp = std::make_shared<const BinaryOp>(std::move(op));
+
+    return detail::run_parallel_loop<T>(
+        executor,
+        size,
+        chunking,
+        [begin, sharedOp, partials, grainSize = chunking.grainSize](
+            std::size_t first, std::size_t last) {
+            using Difference = typename std::iterator_traits<I>::difference_type;
+            const auto chunkEnd = begin + static_cast<Difference>(last);
+            auto it = begin + static_cast<Difference>(first);
+            auto partial = T(*it);
+            for (++it; it != chunkEnd; ++it) {
+                partial = (*sharedOp)(std::move(partial), *it);
+            }
+            (*partials)[first / grainSize].emplace(std::move(partial));
+        },
+        [init = std::move(init), sharedOp, partials](Promise<T>& promise) mutable {
+            for (auto& partial : *partials) {
+                init = (*sharedOp)(std::move(init), *std::move(partial));
+            }
+            promise.set_value(std::move(init));
+        });
+}
+
+/// This overload of parallel_for takes a range, see above for details. Temporary ranges are only
+/// accepted if their iterators do not refer to them, like `std::views::iota`.
+template <typename Range, typename F>
+Future<void>
+parallel_for(const IExecutorPtr& executor, Range&& range, F f, const ParallelOptions& options = {})
+{
+    static_assert(
+        std::ranges::borrowed_range<Range>, "the range must outlive the returned Future");
+    return parallel_for(
+        executor, std::ranges::begin(range), std::ranges::end(range), std::move(f), options);
+}
+
+/// This overload of parallel_transform takes a range, see above for details.
+template <typename Range, typename F>
+auto parallel_transform(
+    const IExecutorPtr& executor, Range&& range, F f, const ParallelOptions& options = {})
+{
+    static_assert(
+        std::ranges::borrowed_range<Range>, "the range must outlive the returned Future");
+    return parallel_transform(
+        executor, std::ranges::begin(range), std::ranges::end(range), std::move(f), options);
+}
+
+/// This overload of parallel_reduce takes a range, see above for details.
+template <typename Range, typename T, typename BinaryOp>
+Future<T> parallel_reduce(
+    const IExecutorPtr& executor,
+    Range&& range,
+    T init,
+    BinaryOp op,
+    const ParallelOptions& options = {})
+{
+    static_assert(
+        std::ranges::borrowed_range<Range>, "the range must outlive the returned Future");
+    return parallel_reduce(
+        executor,
+        std::ranges::begin(range),
+        std::ranges::end(range),
+        std::move(init),
+        std::move(op),
+        options);
+}
+} // namespace asyncly
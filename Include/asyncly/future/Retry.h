@@ -0,0 +1,209 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+#include "asyncly/ExecutorTypes.h"
+#include "asyncly/executor/CurrentExecutor.h"
+#include "asyncly/future/Future.h"
+#include "asyncly/task/Cancelable.h"
+
+namespace asyncly {
+
+///
+/// RetryPolicy describes how often and when `retry` calls the
+/// function again after a failed attempt. The delay before attempt
+/// `n + 1` is `initialDelay * multiplier^(n - 1)`, limited to
+/// `maxDelay`, of which up to the fraction `jitter` is randomly
+/// subtracted so that clients failing at the same time do not retry
+/// in lockstep.
+///
+struct RetryPolicy {
+    /// total number of attempts including the first one
+    std::size_t maxAttempts = 3;
+    clock_type::duration initialDelay = std::chrono::milliseconds(100);
+    double multiplier = 2.0;
+    clock_type::duration maxDelay = std::chrono::seconds(10);
+    /// between `0` (no randomization) and `1` (delays anywhere between zero and the full delay)
+    double jitter = 0.5;
+    /// decides whether an error is worth another attempt, all errors are if unset
+    std::function<bool(std::exception_ptr)> isRetryable;
+};
+
+namespace detail {
+
+inline clock_type::duration retry_delay(const RetryPolicy& policy, std::size_t failedAttempts)
+{
+    using Seconds = std::chrono::duration<double>;
+    auto delay = std::chrono::duration_cast<Seconds>(policy.initialDelay).count();
+    const auto maxDelay = std::chrono::duration_cast<Seconds>(policy.maxDelay).count();
+    for (std::size_t i = 1; i < failedAttempts && delay < maxDelay; i++) {
+        delay *= policy.multiplier;
+    }
+    delay = std::min(delay, maxDelay);
+
+    if (policy.jitter > 0) {
+        thread_local std::minstd_rand engine{ std::random_device{}() };
+        std::uniform_real_distribution<double> distribution{ 1.0 - std::min(policy.jitter, 1.0),
+                                                             1.0 };
+        delay *= distribution(engine);
+    }
+    return std::chrono::duration_cast<clock_type::duration>(Seconds{ delay });
+}
+
+// Shared by all attempts of one retry() call. Attempts are strictly sequential, the mutex only
+// protects against cancellation of the result from another thread.
+template <typename T, typename F>
+class retry_state : public std::enable_shared_from_this<retry_state<T, F>> {
+  public:
+    retry_state(RetryPolicy policy, F f, Promise<T> promise, IExecutorPtr executor)
+        : policy_{ std::move(policy) }
+        , f_{ std::move(f) }
+        , promise_{ std::move(promise) }
+        , executor_{ std::move(executor) }
+    {
+    }
+
+    void start()
+    {
+        promise_.on_cancel([weakSelf = this->weak_from_this()]() {
+            if (auto self = weakSelf.lock()) {
+                self->cancel();
+            }
+        });
+        attempt();
+    }
+
+  private:
+    void attempt()
+    {
+        if (promise_.is_cancelled()) {
+            return;
+        }
+
+        attempts_++;
+        std::optional<Future<T>> future;
+        try {
+            future.emplace(f_());
+        } catch (...) {
+            failed(std::current_exception());
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            current_ = detail::get_future_impl(*future);
+        }
+
+        auto self = this->shared_from_this();
+        if constexpr (std::is_void_v<T>) {
+            future->then([self]() { self->promise_.set_value(); });
+        } else {
+            future->then([self](T value) { self->promise_.set_value(std::move(value)); });
+        }
+        future->catch_error([self](std::exception_ptr error) { self->failed(error); });
+    }
+
+    void failed(std::exception_ptr error)
+    {
+        if (promise_.is_cancelled()) {
+            return;
+        }
+
+        const auto retryable = !policy_.isRetryable || policy_.isRetryable(error);
+        if (!retryable || attempts_ >= policy_.maxAttempts) {
+            promise_.set_exception(error);
+            return;
+        }
+
+        // checked again under the lock, as cancel() would not see a timer scheduled after it ran
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        if (promise_.is_cancelled()) {
+            return;
+        }
+        timer_ = executor_->post_after(
+            retry_delay(policy_, attempts_),
+            [self = this->shared_from_this()]() { self->attempt(); });
+    }
+
+    void cancel()
+    {
+        std::shared_ptr<Cancelable> timer;
+        std::shared_ptr<FutureImpl<T>> current;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            timer = std::move(timer_);
+            current = current_.lock();
+        }
+        if (timer) {
+            timer->cancel();
+        }
+        if (current) {
+            current->cancel();
+        }
+    }
+
+    const RetryPolicy policy_;
+    F f_;
+    Promise<T> promise_;
+    const IExecutorPtr executor_;
+    std::size_t attempts_ = 0;
+
+    std::mutex mutex_;
+    std::shared_ptr<Cancelable> timer_;
+    std::weak_ptr<FutureImpl<T>> current_;
+};
+} // namespace detail
+
+///
+/// retry calls the `Future` returning function `f` until the `Future`
+/// it returns is resolved, the error it is rejected with is not
+/// retryable or `policy.maxAttempts` attempts have failed. In the
+/// latter cases the result is rejected with the last error.
+/// Attempts after the first one are posted with `post_after` to the
+/// current executor. All attempts share one state, so waiting for the
+/// next attempt costs a single timer. Cancelling the result cancels
+/// the pending timer or the current attempt.
+///
+/// Example usage:
+/// \snippet RetryTest.cpp Retry
+///
+template <typename F>
+auto retry(RetryPolicy policy, F f) -> Future<typename std::invoke_result_t<F&>::value_type>
+{
+    using T = typename std::invoke_result_t<F&>::value_type;
+
+    auto lazy = make_lazy_future<T>();
+    std::make_shared<detail::retry_state<T, F>>(
+        std::move(policy), std::move(f), std::get<1>(lazy), this_thread::get_current_executor())
+        ->start();
+    return std::get<0>(std::move(lazy));
+}
+} // namespace asyncly
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+#include "asyncly/future/Future.h"
+#include "asyncly/future/detail/SharedFuture.h"
+
+namespace asyncly {
+
+///
+/// SharedFuture makes the result of a single `Future` available to
+/// any number of consumers. The result is stored exactly once when
+/// the source `Future` settles; consumers that ask for it earlier are
+/// queued and notified at that point, later ones are served
+/// directly. All member functions are thread-safe and copies of a
+/// `SharedFuture` refer to the same result.
+///
+/// Example usage:
+/// \snippet SharedFutureTest.cpp SharedFuture Consumers
+///
+template <typename T> class SharedFuture {
+  public:
+    ///
+    /// Consumes `future`, must be called from within an executor task
+    /// like `Future::then`.
+    ///
+    explicit SharedFuture(Future<T>&& future)
+        : state_{ std::make_shared<detail::SharedFutureState<T>>() }
+    {
+        future.then([state = state_](T value) { state->set_value(std::move(value)); })
+            .catch_error([state = state_](std::exception_ptr e) { state->set_exception(e); });
+    }
+
+    ///
+    /// Creates a `SharedFuture` that is resolved by whoever owns `state`.
+    ///
+    explicit SharedFuture(std::shared_ptr<detail::SharedFutureState<T>> state)
+        : state_{ std::move(state) }
+    {
+    }
+
+    ///
+    /// Returns a `Future` resolved with a copy of the result, which
+    /// requires `T` to be copy-constructible.
+    ///
+    Future<T> get_future() const
+    {
+        static_assert(
+            std::is_copy_constructible_v<T>,
+            "get_future copies the shared value, use get_shared for non-copyable types");
+
+        if (state_->is_settled()) {
+            if (auto error = state_->error()) {
+                return make_exceptional_future<T>(error);
+            }
+            return make_ready_future(*state_->value());
+        }
+
+        auto lazy = make_lazy_future<T>();
+        state_->add_waiter(
+            [promise = std::get<1>(lazy)](
+                const std::shared_ptr<const T>& value, std::exception_ptr error) mutable {
+                if (error) {
+                    promise.set_exception(error);
+                } else {
+                    promise.set_value(*value);
+                }
+            });
+        return std::get<0>(lazy);
+    }
+
+    ///
+    /// Returns a `Future` resolved with a pointer to the one shared
+    /// result, which allows access without copying the value.
+    ///
+    Future<std::shared_ptr<const T>> get_shared() const
+    {
+        if (state_->is_settled()) {
+            if (auto error = state_->error()) {
+                return make_exceptional_future<std::shared_ptr<const T>>(error);
+            }
+            return make_ready_future(state_->value());
+        }
+
+        auto lazy = make_lazy_future<std::shared_ptr<const T>>();
+        state_->add_waiter(
+            [promise = std::get<1>(lazy)](
+                const std::shared_ptr<const T>& value, std::exception_ptr error) mutable {
+                if (error) {
+                    promise.set_exception(error);
+                } else {
+                    promise.set_value(value);
+                }
+            });
+        return std::get<0>(lazy);
+    }
+
+    ///
+    /// Equivalent to `get_shared().then(...)` with the continuation
+    /// being called with a `const T&` to the shared result.
+    ///
+    template <typename F> auto then(F&& f) const
+    {
+        return get_shared().then(
+            [f = std::forward<F>(f)](std::shared_ptr<const T> value) mutable { return f(*value); });
+    }
+
+  private:
+    std::shared_ptr<detail::SharedFutureState<T>> state_;
+};
+
+template <> class SharedFuture<void> {
+  public:
+    explicit SharedFuture(Future<void>&& future)
+        : state_{ std::make_shared<detail::SharedFutureState<void>>() }
+    {
+        future.then([state = state_]() { state->set_value(); })
+            .catch_error([state = state_](std::exception_ptr e) { state->set_exception(e); });
+    }
+
+    explicit SharedFuture(std::shared_ptr<detail::SharedFutureState<void>> state)
+        : state_{ std::move(state) }
+    {
+    }
+
+    Future<void> get_future() const
+    {
+        if (state_->is_settled()) {
+            if (auto error = state_->error()) {
+                return make_exceptional_future<void>(error);
+            }
+            return make_ready_future();
+        }
+
+        auto lazy = make_lazy_future<void>();
+        state_->add_waiter([promise = std::get<1>(lazy)](std::exception_ptr error) mutable {
+            if (error) {
+                promise.set_exception(error);
+            } else {
+                promise.set_value();
+            }
+        });
+        return std::get<0>(lazy);
+    }
+
+  private:
+    std::shared_ptr<detail::SharedFutureState<void>> state_;
+};
+} // namespace asyncly
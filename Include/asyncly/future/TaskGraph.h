@@ -0,0 +1,190 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/future/Future.h"
+#include "asyncly/future/detail/TaskGraph.h"
+
+namespace asyncly {
+
+///
+/// TaskGraph describes work as a directed acyclic graph of tasks
+/// that is built once and can then be run any number of times.
+/// Compared to expressing the same dependencies with `then` and
+/// `when_all`, a run allocates no `Futures` per edge: every node
+/// has an atomic counter of unfinished dependencies and the node
+/// finishing last dispatches it directly.
+///
+/// Tasks are either `void()` or `Future<void>()` callables, the
+/// latter for asynchronous steps. A node only runs once all its
+/// predecessors have succeeded. Runs in progress are not affected by
+/// later modifications of the graph, they run the graph as it was
+/// when they were started. Tasks of concurrent runs of the same graph
+/// are called concurrently. TaskGraph is move-only, because its tasks
+/// are shared with the runs in progress.
+///
+/// Example usage:
+/// \snippet TaskGraphTest.cpp TaskGraph Diamond
+///
+class TaskGraph {
+  public:
+    using NodeId = std::size_t;
+
+    TaskGraph()
+        : nodes_{ std::make_shared<detail::task_graph_nodes>() }
+    {
+    }
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+    TaskGraph(TaskGraph&&) = default;
+    TaskGraph& operator=(TaskGraph&&) = default;
+
+    ///
+    /// adds a node running `task`
+    /// \return the id to refer to the node in `add_dependency`
+    ///
+    template <typename F> NodeId add_task(F&& task)
+    {
+        using R = std::invoke_result_t<F&>;
+        static_assert(
+            std::is_void_v<R> || std::is_same_v<R, Future<void>>,
+            "tasks must return void or Future<void>");
+
+        auto& nodes = mutable_nodes();
+        auto& node = nodes.emplace_back();
+        if constexpr (std::is_void_v<R>) {
+            node.task = std::make_shared<detail::task_graph_node::task_t>(
+                std::in_place_type<detail::task_graph_node::sync_task_t>, std::forward<F>(task));
+        } else {
+            node.task = std::make_shared<detail::task_graph_node::task_t>(
+                std::in_place_type<detail::task_graph_node::async_task_t>, std::forward<F>(task));
+        }
+        return nodes.size() - 1;
+    }
+
+    ///
+    /// makes `successor` run only after `predecessor` has succeeded
+    /// \throw std::invalid_argument if one of the ids is unknown or
+    /// both are the same
+    ///
+    void add_dependency(NodeId predecessor, NodeId successor)
+    {
+        if (predecessor >= nodes_->size() || successor >= nodes_->size()) {
+            throw std::invalid_argument("unknown task graph node");
+        }
+        if (predecessor == successor) {
+            throw std::invalid_argument("a task graph node cannot depend on itself");
+        }
+
+        auto& nodes = mutable_nodes();
+        nodes[predecessor].successors.push_back(successor);
+        nodes[successor].predecessors++;
+    }
+
+    std::size_t size() const
+    {
+        return nodes_->size();
+    }
+
+    ///
+    /// runs all tasks of the graph on `executor`
+    /// \return a `Future` that is resolved once all tasks have
+    /// finished, or rejected with the first error once all tasks that
+    /// have been started are done. A graph containing a cycle is
+    /// rejected with `std::invalid_argument` without running any task.
+    /// Cancelling the `Future` skips all tasks that have not started
+    /// yet.
+    ///
+    Future<void> run(const IExecutorPtr& executor)
+    {
+        if (!validated_) {
+            acyclic_ = find_roots(roots_);
+            validated_ = true;
+        }
+        if (!acyclic_) {
+            return make_exceptional_future<void>(
+                std::invalid_argument("task graph contains a cycle"));
+        }
+        if (nodes_->empty()) {
+            return make_ready_future();
+        }
+
+        auto lazy = make_lazy_future<void>();
+        std::make_shared<detail::task_graph_run>(nodes_, executor, std::get<1>(lazy))
+            ->start(roots_);
+        return std::get<0>(std::move(lazy));
+    }
+
+  private:
+    // Runs in progress share the nodes, they are copied before they are modified so that the runs
+    // keep reading an unchanged graph. The tasks themselves are shared by the copies.
+    detail::task_graph_nodes& mutable_nodes()
+    {
+        if (nodes_.use_count() > 1) {
+            nodes_ = std::make_shared<detail::task_graph_nodes>(*nodes_);
+        }
+        validated_ = false;
+        return *nodes_;
+    }
+
+    // Kahn's algorithm, returns false if not every node can be reached in topological order
+    bool find_roots(std::vector<NodeId>& roots) const
+    {
+        roots.clear();
+        std::vector<std::size_t> remaining(nodes_->size());
+        std::vector<NodeId> ready;
+        for (NodeId node = 0; node < nodes_->size(); node++) {
+            remaining[node] = (*nodes_)[node].predecessors;
+            if (remaining[node] == 0) {
+                roots.push_back(node);
+                ready.push_back(node);
+            }
+        }
+
+        std::size_t visited = 0;
+        while (!ready.empty()) {
+            const auto node = ready.back();
+            ready.pop_back();
+            visited++;
+            for (auto successor : (*nodes_)[node].successors) {
+                if (--remaining[successor] == 0) {
+                    ready.push_back(successor);
+                }
+            }
+        }
+
+        return visited == nodes_->size();
+    }
+
+    std::shared_ptr<detail::task_graph_nodes> nodes_;
+    // result of find_roots(), recomputed on the next run after the graph has been modified
+    bool validated_ = false;
+    bool acyclic_ = false;
+    std::vector<NodeId> roots_;
+};
+} // namespace asyncly
@@ -71,4 +71,15 @@ when_all(I begin, I end)
             typename std::iterator_traits<I>::value_type::value_type>{}) };
 }
 
+/// This overload of when_all takes ownership of a vector of Futures whose size is only known at
+/// runtime. The result vector preserves the order of the input Futures, independent of the order
+/// in which they are resolved.
+template <typename T>
+Future<typename detail::when_all_iterator_result<T>::result_type>
+when_all(std::vector<Future<T>>&& futures)
+{
+    return when_all(
+        std::make_move_iterator(futures.begin()), std::make_move_iterator(futures.end()));
+}
+
 } // namespace asyncly
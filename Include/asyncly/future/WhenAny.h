@@ -18,17 +18,34 @@
 
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "asyncly/future/Future.h"
 #include "asyncly/future/detail/WhenAny.h"
 
 namespace asyncly {
 
 template <typename T> class Future;
 
+/// IndexedValue pairs the value a `Future` has been resolved with and the position of this
+/// `Future` in the range of `Futures` that has been passed to a combinator like `when_any`.
+template <typename T> struct IndexedValue {
+    std::size_t index;
+    T value;
+};
+
+template <> struct IndexedValue<void> {
+    std::size_t index;
+};
+
 ///
 /// when_any can be used to combine multiple `Futures` into another
 /// `Future` that will be resolved when the first of the supplied
 /// `Future` is resolved or rejected when any `Future` is rejected
-/// (whichever happens first).
+/// (whichever happens first). Cancelling the returned `Future` cancels
+/// all supplied `Futures`.
 ///
 /// Example usage:
 /// \snippet WhenAnyTest.cpp WhenAny Combination
@@ -49,4 +66,34 @@ template <typename... Args> Future<detail::when_any_return_types<Args...>> when_
 {
     return { detail::when_any_impl(args...) };
 }
+
+///
+/// This overload of when_any takes a range of `Futures` of the same
+/// type and returns a `Future` that is settled like the first of them
+/// to be resolved or rejected. In contrast to the variadic version,
+/// the result reports which `Future` won by its position in the
+/// range. All other `Futures` are cancelled as soon as the winner is
+/// known, which allows the operations behind them to release their
+/// timers, posted tasks and connections (see `Future::cancel` and
+/// `Promise::on_cancel`). Cancelling the returned `Future` cancels
+/// all supplied `Futures`. An empty range results in a rejected
+/// `Future`.
+///
+/// \return a `Future<IndexedValue<T>>` containing the index and the
+/// value of the winning `Future`
+///
+template <typename I> // I models InputIterator
+Future<IndexedValue<typename std::iterator_traits<I>::value_type::value_type>>
+when_any(I begin, I end)
+{
+    return { detail::when_any_iterator_impl(begin, end) };
+}
+
+/// This overload of when_any takes ownership of a vector of `Futures` whose size is only known at
+/// runtime. See the iterator overload above for details.
+template <typename T> Future<IndexedValue<T>> when_any(std::vector<Future<T>>&& futures)
+{
+    return when_any(
+        std::make_move_iterator(futures.begin()), std::make_move_iterator(futures.end()));
+}
 } // namespace asyncly
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "asyncly/future/Future.h"
+#include "asyncly/future/WhenAny.h"
+#include "asyncly/future/detail/WhenN.h"
+
+namespace asyncly {
+
+///
+/// when_n combines a range of `Futures` of the same type into a
+/// `Future` that is resolved as soon as `k` of them have been
+/// resolved. It is rejected as soon as so many of them have been
+/// rejected that `k` successes are no longer possible, with the error
+/// of the rejection that made it impossible. This covers quorum reads
+/// and "first k of n replicas" requests, with `when_n(1, ...)` being
+/// a `when_any` that tolerates failures.
+///
+/// \param k number of `Futures` that need to be resolved. `0` results
+/// in a `Future` that is resolved immediately, values larger than
+/// the size of the range in a rejected one.
+/// \param begin, end the range of `Futures` to be combined
+/// \param cancelRemaining whether the `Futures` that are still
+/// pending once the result is known should be cancelled (see
+/// `Future::cancel`)
+///
+/// \return a `Future` containing the `k` results in the order in
+/// which they became available, each together with the position of
+/// the `Future` that produced it
+///
+template <typename I> // I models InputIterator
+Future<std::vector<IndexedValue<typename std::iterator_traits<I>::value_type::value_type>>>
+when_n(std::size_t k, I begin, I end, bool cancelRemaining = true)
+{
+    return { detail::when_n_impl(k, begin, end, cancelRemaining) };
+}
+
+/// This overload of when_n takes ownership of a vector of `Futures`, see above for details.
+template <typename T>
+Future<std::vector<IndexedValue<T>>>
+when_n(std::size_t k, std::vector<Future<T>>&& futures, bool cancelRemaining = true)
+{
+    return when_n(
+        k,
+        std::make_move_iterator(futures.begin()),
+        std::make_move_iterator(futures.end()),
+        cancelRemaining);
+}
+} // namespace asyncly
@@ -0,0 +1,225 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "asyncly/ExecutorTypes.h"
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/future/Future.h"
+#include "asyncly/future/detail/SharedFuture.h"
+#include "asyncly/task/Cancelable.h"
+
+namespace asyncly::detail {
+
+/// State behind an AsyncCache. Every entry refers to the SharedFutureState of its load, so all
+/// concurrent callers of get() share one loader call and one stored value. Entries are ordered by
+/// last use in `lru_`, the generation distinguishes an entry from a later one for the same key
+/// after it has been evicted, so that completions and expiry timers of the old one are ignored.
+template <typename K, typename V, typename Hash>
+class AsyncCacheState : public std::enable_shared_from_this<AsyncCacheState<K, V, Hash>> {
+  public:
+    using loader_t = std::function<Future<V>(const K&)>;
+
+    AsyncCacheState(
+        loader_t loader,
+        std::optional<clock_type::duration> ttl,
+        std::size_t maxEntries,
+        IExecutorPtr executor)
+        : loader_{ std::move(loader) }
+        , ttl_{ ttl }
+        , maxEntries_{ maxEntries }
+        , executor_{ std::move(executor) }
+    {
+    }
+
+    std::shared_ptr<SharedFutureState<V>> get(const K& key)
+    {
+        std::shared_ptr<SharedFutureState<V>> state;
+        std::uint64_t generation = 0;
+        std::vector<std::shared_ptr<Cancelable>> timers;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            auto it = entries_.find(key);
+            if (it != entries_.end()) {
+                lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+                return it->second.state;
+            }
+
+            state = std::make_shared<SharedFutureState<V>>();
+            generation = ++generation_;
+            lru_.push_front(key);
+            entries_.emplace(key, Entry{ state, lru_.begin(), generation, nullptr });
+            while (entries_.size() > maxEntries_) {
+                timers.push_back(erase_locked(entries_.find(lru_.back())));
+            }
+        }
+        cancel_all(timers);
+
+        load(key, generation, state);
+        return state;
+    }
+
+    void invalidate(const K& key)
+    {
+        std::shared_ptr<Cancelable> timer;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            auto it = entries_.find(key);
+            if (it == entries_.end()) {
+                return;
+            }
+            timer = erase_locked(it);
+        }
+        if (timer) {
+            timer->cancel();
+        }
+    }
+
+    void clear()
+    {
+        std::vector<std::shared_ptr<Cancelable>> timers;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            for (auto& entry : entries_) {
+                timers.push_back(std::move(entry.second.expiry));
+            }
+            entries_.clear();
+            lru_.clear();
+        }
+        cancel_all(timers);
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        return entries_.size();
+    }
+
+  private:
+    struct Entry {
+        std::shared_ptr<SharedFutureState<V>> state;
+        typename std::list<K>::iterator lruPosition;
+        std::uint64_t generation;
+        std::shared_ptr<Cancelable> expiry;
+    };
+    using entries_t = std::unordered_map<K, Entry, Hash>;
+
+    void load(const K& key, std::uint64_t generation, std::shared_ptr<SharedFutureState<V>> state)
+    {
+        std::optional<Future<V>> future;
+        try {
+            future.emplace(loader_(key));
+        } catch (...) {
+            loaded(key, generation, std::current_exception());
+            state->set_exception(std::current_exception());
+            return;
+        }
+
+        auto weak = this->weak_from_this();
+        future
+            ->then([weak, key, generation, state](V value) {
+                state->set_value(std::move(value));
+                if (auto self = weak.lock()) {
+                    self->loaded(key, generation, nullptr);
+                }
+            })
+            .catch_error([weak, key, generation, state](std::exception_ptr error) {
+                // the entry is removed before the waiters are notified, so that they can retry
+                if (auto self = weak.lock()) {
+                    self->loaded(key, generation, error);
+                }
+                state->set_exception(error);
+            });
+    }
+
+    // failed loads are not cached, successful ones start their time to live
+    void loaded(const K& key, std::uint64_t generation, std::exception_ptr error)
+    {
+        std::shared_ptr<Cancelable> timer;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            auto it = entries_.find(key);
+            if (it == entries_.end() || it->second.generation != generation) {
+                return;
+            }
+            if (error) {
+                timer = erase_locked(it);
+            } else if (ttl_) {
+                it->second.expiry = executor_->post_after(
+                    *ttl_, [weak = this->weak_from_this(), key, generation]() {
+                        if (auto self = weak.lock()) {
+                            self->expire(key, generation);
+                        }
+                    });
+            }
+        }
+        if (timer) {
+            timer->cancel();
+        }
+    }
+
+    void expire(const K& key, std::uint64_t generation)
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        auto it = entries_.find(key);
+        if (it != entries_.end() && it->second.generation == generation) {
+            erase_locked(it);
+        }
+    }
+
+    // returns the expiry timer of the erased entry, to be cancelled outside of the lock
+    std::shared_ptr<Cancelable> erase_locked(typename entries_t::iterator it)
+    {
+        auto timer = std::move(it->second.expiry);
+        lru_.erase(it->second.lruPosition);
+        entries_.erase(it);
+        return timer;
+    }
+
+    static void cancel_all(const std::vector<std::shared_ptr<Cancelable>>& timers)
+    {
+        for (const auto& timer : timers) {
+            if (timer) {
+                timer->cancel();
+            }
+        }
+    }
+
+    const loader_t loader_;
+    const std::optional<clock_type::duration> ttl_;
+    const std::size_t maxEntries_;
+    const IExecutorPtr executor_;
+
+    mutable std::mutex mutex_;
+    entries_t entries_;
+    std::list<K> lru_;
+    std::uint64_t generation_ = 0;
+};
+} // namespace asyncly::detail
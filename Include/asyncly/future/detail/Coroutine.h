@@ -30,6 +30,7 @@
 #include <coroutine>
 #include <memory>
 #include <optional>
+#include <type_traits>
 
 namespace asyncly {
 
@@ -43,7 +44,7 @@ template <typename T> struct coro_awaiter {
     ~coro_awaiter();
     bool await_ready();
     // todo: use bool-version to shortcut ready futures
-    void await_suspend(std::coroutine_handle<> coroutine_handle);
+    template <typename P> void await_suspend(std::coroutine_handle<P> coroutine_handle);
     T await_resume();
 
   private:
@@ -57,7 +58,7 @@ template <> struct coro_awaiter<void> {
     ~coro_awaiter();
     bool await_ready();
     // todo: use bool-version to shortcut ready futures
-    void await_suspend(std::coroutine_handle<> coroutine_handle);
+    template <typename P> void await_suspend(std::coroutine_handle<P> coroutine_handle);
     void await_resume();
 
   private:
@@ -65,6 +66,11 @@ template <> struct coro_awaiter<void> {
     std::exception_ptr error_;
 };
 
+template <typename T> struct coro_promise;
+
+template <typename P> struct is_coro_promise : std::false_type { };
+template <typename T> struct is_coro_promise<coro_promise<T>> : std::true_type { };
+
 template <typename T> struct coro_promise {
     std::unique_ptr<Promise<T>> promise_;
     coro_promise();
@@ -53,13 +53,33 @@ template <typename T> bool coro_awaiter<T>::await_ready()
     return false;
 }
 
+// Cancelling the Future returned by a coroutine cancels the Future it is currently suspended on,
+// which resumes the coroutine with asyncly::Cancelled.
+template <typename T, typename P>
+void forward_coroutine_cancellation(std::coroutine_handle<P> coroutine_handle, Future<T>& future)
+{
+    if constexpr (is_coro_promise<P>::value) {
+        coroutine_handle.promise().promise_->on_cancel(
+            [weakFuture = std::weak_ptr{ get_future_impl(future) }]() {
+                if (auto awaited = weakFuture.lock()) {
+                    awaited->cancel();
+                }
+            });
+    }
+}
+
 // todo: use bool-version to shortcut ready futures
-template <typename T> void coro_awaiter<T>::await_suspend(std::coroutine_handle<> coroutine_handle)
+template <typename T>
+template <typename P>
+void coro_awaiter<T>::await_suspend(std::coroutine_handle<P> coroutine_handle)
 {
 #ifdef ASYNCLY_FUTURE_DEBUG
     std::cerr << "await_suspend"
               << " on thread " << std::this_thread::get_id() << std::endl;
 #endif
+    // must happen before the continuations are attached, as these may resume and finish the
+    // coroutine on another thread right away
+    forward_coroutine_cancellation(coroutine_handle, *future_);
     auto executor = this_thread::get_current_executor();
     future_
         ->catch_error([this, coroutine_handle, executor](auto e) mutable {
@@ -75,7 +95,7 @@ template <typename T> void coro_awaiter<T>::await_suspend(std::coroutine_handle<
             std::cerr << "then: coroutine_handle.resume() with value " << value << " on thread "
                       << std::this_thread::get_id() << std::endl;
 #endif
-            value_.emplace(value);
+            value_.emplace(std::move(value));
             executor->post([coroutine_handle]() mutable { coroutine_handle.resume(); });
         });
 }
@@ -89,7 +109,7 @@ template <typename T> T coro_awaiter<T>::await_resume()
 #endif
         std::rethrow_exception(error_);
     } else {
-        auto value = *value_;
+        auto value = std::move(*value_);
 #ifdef ASYNCLY_FUTURE_DEBUG
         std::cerr << "await_resume with value " << value << " on thread "
                   << std::this_thread::get_id() << std::endl;
@@ -125,12 +145,16 @@ inline bool coro_awaiter<void>::await_ready()
 }
 
 // todo: use bool-version to shortcut ready futures
-inline void coro_awaiter<void>::await_suspend(std::coroutine_handle<> coroutine_handle)
+template <typename P>
+void coro_awaiter<void>::await_suspend(std::coroutine_handle<P> coroutine_handle)
 {
 #ifdef ASYNCLY_FUTURE_DEBUG
     std::cerr << "await_suspend"
               << " on thread " << std::this_thread::get_id() << std::endl;
 #endif
+    // must happen before the continuations are attached, as these may resume and finish the
+    // coroutine on another thread right away
+    forward_coroutine_cancellation(coroutine_handle, *future_);
     auto executor = this_thread::get_current_executor();
     future_
         ->catch_error([this, coroutine_handle, executor](auto e) mutable {
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <exception>
 #include <iostream>
 #include <memory>
@@ -27,7 +28,9 @@
 
 #include <function2/function2.hpp>
 
+#include "asyncly/future/Cancelled.h"
 #include "asyncly/future/detail/Coroutine.h"
+#include "asyncly/task/CancellationToken.h"
 
 #include "asyncly/detail/TypeUtils.h"
 
@@ -45,6 +48,9 @@ std::shared_ptr<FutureImpl<typename std::decay_t<T>>> make_ready_future_impl(T&&
 inline std::shared_ptr<FutureImpl<void>> make_ready_future_impl();
 template <typename T>
 std::shared_ptr<FutureImpl<T>> make_exceptional_future_impl(std::exception_ptr e);
+template <typename T> std::shared_ptr<FutureImpl<T>> get_future_impl(Future<T>& future);
+
+using cancel_handler_t = fu2::unique_function<void()>;
 
 template <typename T> class PromiseImplBase {
   public:
@@ -52,6 +58,8 @@ template <typename T> class PromiseImplBase {
 
     void set_exception(std::exception_ptr e);
     std::shared_ptr<FutureImpl<T>> get_future();
+    void on_cancel(cancel_handler_t handler);
+    bool is_cancelled() const;
 
   protected:
     const std::shared_ptr<FutureImpl<T>> future_;
@@ -121,7 +129,8 @@ struct Rejected {
 struct Continued { };
 } // namespace future_state
 
-template <typename T> class FutureImplBase : public ErrorSink {
+template <typename T>
+class FutureImplBase : public ErrorSink, public std::enable_shared_from_this<FutureImplBase<T>> {
   public:
     template <typename F>
     typename std::shared_ptr<FutureImpl<continuation_future_element_type<T, F>>>
@@ -129,9 +138,23 @@ template <typename T> class FutureImplBase : public ErrorSink {
     template <typename F> void catch_error(F&& f);
     template <typename F> void catch_and_forward_error(F&& f);
 
+    /// Rejects a pending future with asyncly::Cancelled and invokes its cancel handler, which
+    /// usually cancels whatever was going to resolve it. Values or errors that are delivered
+    /// to a cancelled future afterwards are dropped.
+    void cancel();
+    bool is_cancelled() const;
+    void set_cancel_handler(cancel_handler_t handler);
+
+    /// Cancels this future once `token` is cancelled. The token is inherited by futures created
+    /// by then(), so it covers the rest of the chain as well.
+    void set_cancellation_token(const CancellationToken& token);
+
   protected:
     FutureImplBase();
 
+    // must be called with mutex_ held and state_ being Ready
+    void reject_locked(future_state::Ready<T>& ready, std::exception_ptr error);
+
   public:
     void notify_error_ready(std::exception_ptr) override;
 
@@ -147,6 +170,11 @@ template <typename T> class FutureImplBase : public ErrorSink {
     bool onErrorSet_;
     bool errorBreaksContinuationChain_ = true;
 
+    cancel_handler_t onCancel_;
+    std::atomic<bool> cancelled_;
+    CancellationToken token_;
+    CancellationRegistration tokenRegistration_;
+
     std::mutex mutex_;
 };
 
@@ -84,6 +84,16 @@ template <typename T> std::shared_ptr<FutureImpl<T>> PromiseImplBase<T>::get_fut
     return future_;
 }
 
+template <typename T> void PromiseImplBase<T>::on_cancel(cancel_handler_t handler)
+{
+    future_->set_cancel_handler(std::move(handler));
+}
+
+template <typename T> bool PromiseImplBase<T>::is_cancelled() const
+{
+    return future_->is_cancelled();
+}
+
 template <typename T>
 PromiseImpl<T>::PromiseImpl(const std::shared_ptr<FutureImpl<T>>& future)
     : PromiseImplBase<T>{ future }
@@ -143,6 +153,18 @@ std::tuple<std::shared_ptr<FutureImpl<T>>, std::shared_ptr<PromiseImpl<T>>> make
 
 namespace {
 
+/// Makes cancelling the future belonging to `promise` cancel `future`, which is the future
+/// returned by a continuation and is going to resolve `promise`.
+template <typename U, typename F>
+void forward_cancellation(const std::shared_ptr<PromiseImpl<U>>& promise, F& future)
+{
+    promise->on_cancel([weakFuture = std::weak_ptr{ get_future_impl(future) }]() {
+        if (auto future = weakFuture.lock()) {
+            future->cancel();
+        }
+    });
+}
+
 /// Binder classes for continuations, these can be replaced by move-capture lambdas in C++14
 template <typename T, typename F, typename U> struct FutureVoidBinder {
     FutureVoidBinder(T value, F continuation, std::shared_ptr<PromiseImpl<U>> promise)
@@ -158,9 +180,13 @@ template <typename T, typename F, typename U> struct FutureVoidBinder {
     void operator()()
     {
         auto promise = promise_;
+        if (promise->is_cancelled()) {
+            return;
+        }
         try {
-            maybe_unpack_and_call<T>{}(continuation_, std::move(value_))
-                .then([promise]() { promise->set_value(); })
+            auto future = maybe_unpack_and_call<T>{}(continuation_, std::move(value_));
+            forward_cancellation(promise, future);
+            future.then([promise]() { promise->set_value(); })
                 .catch_error([promise](std::exception_ptr e) { promise->set_exception(e); });
         } catch (...) {
             auto e = std::current_exception();
@@ -187,9 +213,13 @@ template <typename F, typename U> struct FutureVoidBinder<void, F, U> {
     void operator()()
     {
         auto promise = promise_;
+        if (promise->is_cancelled()) {
+            return;
+        }
         try {
-            continuation_()
-                .then([promise]() { promise->set_value(); })
+            auto future = continuation_();
+            forward_cancellation(promise, future);
+            future.then([promise]() { promise->set_value(); })
                 .catch_error([promise](std::exception_ptr e) { promise->set_exception(e); });
         } catch (...) {
             auto e = std::current_exception();
@@ -217,9 +247,13 @@ template <typename T, typename F, typename U> struct FutureValueBinder {
     void operator()()
     {
         auto promise = promise_;
+        if (promise->is_cancelled()) {
+            return;
+        }
         try {
-            maybe_unpack_and_call<T>{}(continuation_, std::move(value_))
-                .then([promise](U result) { promise->set_value(std::forward<U>(result)); })
+            auto future = maybe_unpack_and_call<T>{}(continuation_, std::move(value_));
+            forward_cancellation(promise, future);
+            future.then([promise](U result) { promise->set_value(std::forward<U>(result)); })
                 .catch_error([promise](std::exception_ptr e) { promise->set_exception(e); });
         } catch (...) {
             auto e = std::current_exception();
@@ -246,9 +280,13 @@ template <typename F, typename U> struct FutureValueBinder<void, F, U> {
     void operator()()
     {
         auto promise = promise_;
+        if (promise->is_cancelled()) {
+            return;
+        }
         try {
-            continuation_()
-                .then(maybe_pack_and_save<U>{ promise })
+            auto future = continuation_();
+            forward_cancellation(promise, future);
+            future.then(maybe_pack_and_save<U>{ promise })
                 .catch_error([promise](std::exception_ptr e) { promise->set_exception(e); });
         } catch (...) {
             auto e = std::current_exception();
@@ -274,6 +312,9 @@ template <typename T, typename F, typename U> struct NonFutureVoidBinder {
 
     void operator()()
     {
+        if (promise_->is_cancelled()) {
+            return;
+        }
         try {
             maybe_unpack_and_call<T>{}(continuation_, std::move(value_));
             promise_->set_value();
@@ -301,6 +342,9 @@ template <typename F, typename U> struct NonFutureVoidBinder<void, F, U> {
 
     void operator()()
     {
+        if (promise_->is_cancelled()) {
+            return;
+        }
         try {
             continuation_();
         } catch (...) {
@@ -329,6 +373,9 @@ template <typename T, typename F, typename U> struct NonFutureValueBinder {
 
     void operator()()
     {
+        if (promise_->is_cancelled()) {
+            return;
+        }
         try {
             auto result = maybe_unpack_and_call<T>{}(continuation_, std::move(value_));
             promise_->set_value(std::forward<U>(result));
@@ -356,6 +403,9 @@ template <typename F, typename U> struct NonFutureValueBinder<void, F, U> {
 
     void operator()()
     {
+        if (promise_->is_cancelled()) {
+            return;
+        }
         try {
             auto result = continuation_();
             promise_->set_value(std::forward<U>(result));
@@ -425,6 +475,7 @@ FutureImplBase<T>::FutureImplBase()
     : state_{ future_state::Ready<T>{} }
     , continuationSet_(false)
     , onErrorSet_(false)
+    , cancelled_(false)
 {
 }
 
@@ -446,6 +497,14 @@ FutureImplBase<T>::then(F&& continuation)
     std::shared_ptr<PromiseImpl<ContinuationT>> promise;
     std::tie(future, promise) = make_lazy_future_impl<ContinuationT>();
 
+    // Nobody but the continuation is interested in the value of this future, so cancelling the
+    // continuation cancels whatever produces the value as well.
+    future->set_cancel_handler([weakParent = this->weak_from_this()]() {
+        if (auto parent = weakParent.lock()) {
+            parent->cancel();
+        }
+    });
+
     auto continuationTmp = make_continuation<T, ContinuationT>::create(
         this_thread::get_current_executor(), std::forward<F>(continuation), std::move(promise));
 
@@ -468,6 +527,13 @@ FutureImplBase<T>::then(F&& continuation)
             }),
         state_);
 
+    auto token = token_;
+    lock.unlock();
+
+    // A cancelled token cancels the new future right away, which in turn cancels this one, so
+    // this has to happen without holding mutex_.
+    future->set_cancellation_token(token);
+
     return future;
 }
 
@@ -558,28 +624,103 @@ void FutureImplBase<T>::catch_and_forward_error(F&& errorCallback)
         state_);
 }
 
+template <typename T> void FutureImplBase<T>::cancel()
+{
+    cancel_handler_t onCancel;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        auto ready = std::get_if<future_state::Ready<T>>(&state_);
+        if (!ready || cancelled_) {
+            return;
+        }
+
+        cancelled_ = true;
+        onCancel = std::move(onCancel_);
+        tokenRegistration_.reset();
+        reject_locked(*ready, std::make_exception_ptr(Cancelled{}));
+    }
+
+    // The handler typically cancels futures further up the chain. Those lock their own mutex
+    // and notify this future afterwards, so it must not be called while holding mutex_.
+    if (onCancel) {
+        onCancel();
+    }
+}
+
+template <typename T> bool FutureImplBase<T>::is_cancelled() const
+{
+    return cancelled_;
+}
+
+template <typename T> void FutureImplBase<T>::set_cancel_handler(cancel_handler_t handler)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!cancelled_) {
+            if (std::holds_alternative<future_state::Ready<T>>(state_)) {
+                onCancel_ = std::move(handler);
+            }
+            return;
+        }
+    }
+    handler();
+}
+
+template <typename T>
+void FutureImplBase<T>::set_cancellation_token(const CancellationToken& token)
+{
+    if (!token.can_be_cancelled()) {
+        return;
+    }
+
+    auto registration = token.on_cancel([weakSelf = this->weak_from_this()]() {
+        if (auto self = weakSelf.lock()) {
+            self->cancel();
+        }
+    });
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    token_ = token;
+    if (std::holds_alternative<future_state::Ready<T>>(state_) && !cancelled_) {
+        tokenRegistration_ = std::move(registration);
+    }
+}
+
 template <typename T> void FutureImplBase<T>::notify_error_ready(std::exception_ptr error)
 {
     std::unique_lock<std::mutex> lock(FutureImplBase<T>::mutex_);
 
+    if (cancelled_) {
+        return;
+    }
+
     auto ready = std::get_if<future_state::Ready<T>>(&state_);
     if (!ready) {
         throw std::runtime_error("future already in final state");
     }
 
-    if (ready->onError_) {
+    onCancel_ = nullptr;
+    tokenRegistration_.reset();
+    reject_locked(*ready, error);
+}
+
+template <typename T>
+void FutureImplBase<T>::reject_locked(future_state::Ready<T>& ready, std::exception_ptr error)
+{
+    if (ready.onError_) {
         try {
-            ready->onError_(error);
+            ready.onError_(error);
         } catch (const ExecutorStoppedException&) {
         }
         if (!errorBreaksContinuationChain_) {
-            if (auto errorObserver = ready->errorObserver_.lock()) {
+            if (auto errorObserver = ready.errorObserver_.lock()) {
                 errorObserver->notify_error_ready(error);
             }
         }
         state_ = future_state::Continued{};
     } else {
-        if (auto errorObserver = ready->errorObserver_.lock()) {
+        if (auto errorObserver = ready.errorObserver_.lock()) {
             errorObserver->notify_error_ready(error);
         }
         state_ = future_state::Rejected{ error };
@@ -590,11 +731,18 @@ template <typename T> void FutureImpl<T>::notify_value_ready(const T& value)
 {
     std::unique_lock<std::mutex> lock(this->mutex_);
 
+    if (this->cancelled_) {
+        return;
+    }
+
     auto ready = std::get_if<future_state::Ready<T>>(&this->state_);
     if (!ready) {
         throw std::runtime_error("future already in final state");
     }
 
+    this->onCancel_ = nullptr;
+    this->tokenRegistration_.reset();
+
     if (ready->continuation_) {
         try {
             ready->continuation_(value);
@@ -610,11 +758,18 @@ template <typename T> void FutureImpl<T>::notify_value_ready(T&& value)
 {
     std::unique_lock<std::mutex> lock(this->mutex_);
 
+    if (this->cancelled_) {
+        return;
+    }
+
     auto ready = std::get_if<future_state::Ready<T>>(&this->state_);
     if (!ready) {
         throw std::runtime_error("future already in final state");
     }
 
+    this->onCancel_ = nullptr;
+    this->tokenRegistration_.reset();
+
     if (ready->continuation_) {
         try {
             ready->continuation_(std::forward<T>(value));
@@ -630,11 +785,18 @@ inline void FutureImpl<void>::notify_value_ready()
 {
     std::unique_lock<std::mutex> lock(mutex_);
 
+    if (cancelled_) {
+        return;
+    }
+
     auto ready = std::get_if<future_state::Ready<void>>(&state_);
     if (!ready) {
         throw std::runtime_error("future already in final state");
     }
 
+    onCancel_ = nullptr;
+    tokenRegistration_.reset();
+
     if (ready->continuation_) {
         try {
             ready->continuation_();
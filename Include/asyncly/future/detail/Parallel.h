@@ -0,0 +1,178 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/future/Future.h"
+
+namespace asyncly::detail {
+
+// Every task claims several chunks, so tasks that are done early take over the work of slower
+// ones instead of waiting for them.
+constexpr std::size_t kParallelChunksPerTask = 4;
+
+struct parallel_chunking {
+    std::size_t tasks;
+    std::size_t grainSize;
+    std::size_t chunks;
+};
+
+inline parallel_chunking
+make_parallel_chunking(std::size_t size, std::size_t maxTasks, std::size_t grainSize)
+{
+    if (maxTasks == 0) {
+        maxTasks = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    if (grainSize == 0) {
+        grainSize = std::max<std::size_t>(1, size / (maxTasks * kParallelChunksPerTask));
+    }
+    const auto chunks = (size + grainSize - 1) / grainSize;
+    return { std::min(maxTasks, chunks), grainSize, chunks };
+}
+
+// Shared by all tasks of one invocation of a parallel algorithm. Chunks are claimed from an atomic
+// cursor, so nothing is allocated per element or per chunk. The promise is settled by whichever
+// task returns last, which guarantees that the input range is not accessed anymore once the
+// Future is resolved or rejected.
+template <typename T, typename Body, typename Finish> class parallel_loop_state {
+  public:
+    parallel_loop_state(
+        std::size_t size,
+        const parallel_chunking& chunking,
+        Body body,
+        Finish finish,
+        Promise<T> promise)
+        : size_{ size }
+        , grainSize_{ chunking.grainSize }
+        , body_{ std::move(body) }
+        , finish_{ std::move(finish) }
+        , promise_{ std::move(promise) }
+        , remainingTasks_{ chunking.tasks }
+    {
+    }
+
+    void run()
+    {
+        while (!failed_.load(std::memory_order_relaxed) && !promise_.is_cancelled()) {
+            const auto first = next_.fetch_add(grainSize_, std::memory_order_relaxed);
+            if (first >= size_) {
+                break;
+            }
+            try {
+                body_(first, std::min(first + grainSize_, size_));
+            } catch (...) {
+                fail(std::current_exception());
+            }
+        }
+
+        complete(1);
+    }
+
+    // Called instead of run() for the tasks that could not be posted. Stops the tasks that have
+    // been posted already from claiming further chunks and rejects the promise once they are done.
+    void abort_dispatch(std::exception_ptr error, std::size_t notPostedTasks)
+    {
+        fail(std::move(error));
+        complete(notPostedTasks);
+    }
+
+  private:
+    void fail(std::exception_ptr error)
+    {
+        if (!failed_.exchange(true, std::memory_order_relaxed)) {
+            error_ = std::move(error);
+        }
+    }
+
+    void complete(std::size_t tasks)
+    {
+        if (remainingTasks_.fetch_sub(tasks, std::memory_order_acq_rel) != tasks) {
+            return;
+        }
+
+        // cancellation is sticky, so this also covers chunks skipped because of it
+        if (promise_.is_cancelled()) {
+            return;
+        }
+
+        if (failed_.load(std::memory_order_relaxed)) {
+            promise_.set_exception(error_);
+            return;
+        }
+
+        try {
+            finish_(promise_);
+        } catch (...) {
+            promise_.set_exception(std::current_exception());
+        }
+    }
+
+    const std::size_t size_;
+    const std::size_t grainSize_;
+    const Body body_;
+    Finish finish_;
+    Promise<T> promise_;
+    std::atomic<std::size_t> next_{ 0 };
+    std::atomic<std::size_t> remainingTasks_;
+    std::atomic<bool> failed_{ false };
+    std::exception_ptr error_;
+};
+
+// Body is called concurrently with half-open index ranges [first, last) of the input, Finish
+// once with the promise after all chunks have been processed successfully.
+template <typename T, typename Body, typename Finish>
+Future<T> run_parallel_loop(
+    const IExecutorPtr& executor,
+    std::size_t size,
+    const parallel_chunking& chunking,
+    Body body,
+    Finish finish)
+{
+    auto lazy = make_lazy_future<T>();
+    auto promise = std::get<1>(lazy);
+
+    if (size == 0) {
+        finish(promise);
+        return std::get<0>(std::move(lazy));
+    }
+
+    auto state = std::make_shared<parallel_loop_state<T, Body, Finish>>(
+        size, chunking, std::move(body), std::move(finish), std::move(promise));
+    for (std::size_t i = 0; i < chunking.tasks; i++) {
+        try {
+            executor->post([state]() { state->run(); });
+        } catch (...) {
+            // the tasks posted so far may already be running, so throwing would leave the caller
+            // with a failed call that still has side effects
+            state->abort_dispatch(std::current_exception(), chunking.tasks - i);
+            break;
+        }
+    }
+
+    return std::get<0>(std::move(lazy));
+}
+} // namespace asyncly::detail
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <function2/function2.hpp>
+
+namespace asyncly::detail {
+
+/// State behind a SharedFuture: a single slot the result is stored in once, plus the list of
+/// waiters that asked for it before it was available. The result is immutable after it has been
+/// stored, so it is handed to all waiters by reference instead of being copied per waiter.
+template <typename T> class SharedFutureState {
+  public:
+    using waiter_t
+        = fu2::unique_function<void(const std::shared_ptr<const T>&, std::exception_ptr)>;
+
+    void set_value(T&& value)
+    {
+        settle(std::make_shared<const T>(std::move(value)), nullptr);
+    }
+
+    void set_value(const T& value)
+    {
+        settle(std::make_shared<const T>(value), nullptr);
+    }
+
+    void set_exception(std::exception_ptr error)
+    {
+        settle(nullptr, error);
+    }
+
+    /// calls the waiter right away if the result is already available
+    void add_waiter(waiter_t waiter)
+    {
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            if (!settled_) {
+                waiters_.push_back(std::move(waiter));
+                return;
+            }
+        }
+        waiter(value_, error_);
+    }
+
+    bool is_settled() const
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        return settled_;
+    }
+
+    // only valid once is_settled() returned true
+    const std::shared_ptr<const T>& value() const
+    {
+        return value_;
+    }
+
+    // only valid once is_settled() returned true
+    std::exception_ptr error() const
+    {
+        return error_;
+    }
+
+  private:
+    void settle(std::shared_ptr<const T> value, std::exception_ptr error)
+    {
+        std::vector<waiter_t> waiters;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            if (settled_) {
+                throw std::runtime_error("shared future already in final state");
+            }
+            value_ = std::move(value);
+            error_ = error;
+            settled_ = true;
+            waiters.swap(waiters_);
+        }
+
+        for (auto& waiter : waiters) {
+            waiter(value_, error_);
+        }
+    }
+
+    mutable std::mutex mutex_;
+    bool settled_ = false;
+    std::shared_ptr<const T> value_;
+    std::exception_ptr error_;
+    std::vector<waiter_t> waiters_;
+};
+
+template <> class SharedFutureState<void> {
+  public:
+    using waiter_t = fu2::unique_function<void(std::exception_ptr)>;
+
+    void set_value()
+    {
+        settle(nullptr);
+    }
+
+    void set_exception(std::exception_ptr error)
+    {
+        settle(error);
+    }
+
+    /// calls the waiter right away if the result is already available
+    void add_waiter(waiter_t waiter)
+    {
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            if (!settled_) {
+                waiters_.push_back(std::move(waiter));
+                return;
+            }
+        }
+        waiter(error_);
+    }
+
+    bool is_settled() const
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        return settled_;
+    }
+
+    // only valid once is_settled() returned true
+    std::exception_ptr error() const
+    {
+        return error_;
+    }
+
+  private:
+    void settle(std::exception_ptr error)
+    {
+        std::vector<waiter_t> waiters;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            if (settled_) {
+                throw std::runtime_error("shared future already in final state");
+            }
+            error_ = error;
+            settled_ = true;
+            waiters.swap(waiters_);
+        }
+
+        for (auto& waiter : waiters) {
+            waiter(error_);
+        }
+    }
+
+    mutable std::mutex mutex_;
+    bool settled_ = false;
+    std::exception_ptr error_;
+    std::vector<waiter_t> waiters_;
+};
+
+/// converts the error types accepted by Promise::set_exception to an std::exception_ptr
+template <typename E> std::exception_ptr to_exception_ptr(E e)
+{
+    if constexpr (std::is_same_v<E, std::exception_ptr>) {
+        return e;
+    } else if constexpr (std::is_convertible_v<E, std::string>) {
+        return std::make_exception_ptr(std::runtime_error{ e });
+    } else {
+        static_assert(
+            std::is_base_of_v<std::exception, E>,
+            "your error types should inherit from std::exception");
+        return std::make_exception_ptr(e);
+    }
+}
+} // namespace asyncly::detail
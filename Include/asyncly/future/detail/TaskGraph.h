@@ -0,0 +1,184 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <variant>
+#include <vector>
+
+#include <function2/function2.hpp>
+
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/future/Future.h"
+
+namespace asyncly::detail {
+
+struct task_graph_node {
+    using sync_task_t = fu2::unique_function<void()>;
+    using async_task_t = fu2::unique_function<Future<void>()>;
+    using task_t = std::variant<sync_task_t, async_task_t>;
+
+    // shared with the copies of the nodes that runs in progress keep, tasks are not copyable
+    std::shared_ptr<task_t> task;
+    std::vector<std::size_t> successors;
+    std::size_t predecessors = 0;
+};
+
+using task_graph_nodes = std::vector<task_graph_node>;
+
+// State of a single run of a TaskGraph. Every node has an atomic counter of the dependencies it is
+// still waiting for, the node that brings it to zero dispatches it. `inflight_` counts the nodes
+// that are dispatched but not done yet, the run is over once it drops to zero.
+class task_graph_run : public std::enable_shared_from_this<task_graph_run> {
+  public:
+    task_graph_run(
+        std::shared_ptr<const task_graph_nodes> nodes,
+        IExecutorPtr executor,
+        Promise<void> promise)
+        : nodes_{ std::move(nodes) }
+        , executor_{ std::move(executor) }
+        , promise_{ std::move(promise) }
+        , dependencies_(nodes_->size())
+    {
+        for (std::size_t i = 0; i < nodes_->size(); i++) {
+            dependencies_[i].store((*nodes_)[i].predecessors, std::memory_order_relaxed);
+        }
+    }
+
+    void start(const std::vector<std::size_t>& roots)
+    {
+        inflight_.store(roots.size(), std::memory_order_relaxed);
+        for (auto root : roots) {
+            post(root);
+        }
+    }
+
+  private:
+    void post(std::size_t node)
+    {
+        executor_->post([self = shared_from_this(), node]() { self->execute(node); });
+    }
+
+    void execute(std::size_t node)
+    {
+        // a ready successor is executed right away on this thread instead of being posted, so a
+        // chain of nodes only costs a single task
+        while (true) {
+            if (failed_.load(std::memory_order_relaxed) || promise_.is_cancelled()) {
+                finish_one();
+                return;
+            }
+
+            auto& task = *(*nodes_)[node].task;
+            if (auto syncTask = std::get_if<task_graph_node::sync_task_t>(&task)) {
+                try {
+                    (*syncTask)();
+                } catch (...) {
+                    fail(std::current_exception());
+                    return;
+                }
+
+                auto next = complete(node);
+                if (!next) {
+                    return;
+                }
+                node = *next;
+            } else {
+                execute_async(std::get<task_graph_node::async_task_t>(task), node);
+                return;
+            }
+        }
+    }
+
+    void execute_async(task_graph_node::async_task_t& task, std::size_t node)
+    {
+        std::optional<Future<void>> future;
+        try {
+            future.emplace(task());
+        } catch (...) {
+            fail(std::current_exception());
+            return;
+        }
+
+        future
+            ->then([self = shared_from_this(), node]() {
+                if (auto next = self->complete(node)) {
+                    self->execute(*next);
+                }
+            })
+            .catch_error([self = shared_from_this()](std::exception_ptr e) { self->fail(e); });
+    }
+
+    // Marks `node` as done and dispatches the successors that became ready. One of them is
+    // returned instead of being posted, it takes over the inflight slot of `node`.
+    std::optional<std::size_t> complete(std::size_t node)
+    {
+        std::optional<std::size_t> next;
+        for (auto successor : (*nodes_)[node].successors) {
+            if (dependencies_[successor].fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                continue;
+            }
+            if (!next) {
+                next = successor;
+                continue;
+            }
+            inflight_.fetch_add(1, std::memory_order_relaxed);
+            post(successor);
+        }
+
+        if (!next) {
+            finish_one();
+        }
+        return next;
+    }
+
+    void fail(std::exception_ptr error)
+    {
+        if (!failed_.exchange(true, std::memory_order_relaxed)) {
+            error_ = error;
+        }
+        finish_one();
+    }
+
+    void finish_one()
+    {
+        if (inflight_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+
+        if (failed_.load(std::memory_order_relaxed)) {
+            promise_.set_exception(error_);
+        } else {
+            promise_.set_value();
+        }
+    }
+
+    const std::shared_ptr<const task_graph_nodes> nodes_;
+    const IExecutorPtr executor_;
+    Promise<void> promise_;
+    std::vector<std::atomic<std::size_t>> dependencies_;
+    std::atomic<std::size_t> inflight_{ 0 };
+    std::atomic<bool> failed_{ false };
+    std::exception_ptr error_;
+};
+} // namespace asyncly::detail
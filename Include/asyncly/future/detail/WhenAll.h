@@ -19,10 +19,12 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <exception>
 #include <iterator>
 #include <memory>
 #include <optional>
+#include <tuple>
 #include <vector>
 
 #include <boost/mp11.hpp>
@@ -119,6 +121,12 @@ template <typename... Args> struct when_all_result_container {
     swap_void_for_bool<Args...> results;
     bool alreadyContinued = false;
 };
+template <typename F> void cancel_if_alive(const std::weak_ptr<F>& weakFuture)
+{
+    if (auto future = weakFuture.lock()) {
+        future->cancel();
+    }
+}
 } // namespace
 
 template <typename... Args>
@@ -167,6 +175,13 @@ when_all_impl(std::shared_ptr<FutureImpl<Args>>... args)
             });
     });
 
+    // nobody else can observe the inputs, so cancelling the combined future cancels all of them
+    auto weakFutures = std::make_tuple(std::weak_ptr<FutureImpl<Args>>{ args }...);
+    promise->on_cancel([weakFutures = std::move(weakFutures)]() {
+        std::apply(
+            [](const auto&... weakFuture) { (cancel_if_alive(weakFuture), ...); }, weakFutures);
+    });
+
     return future;
 }
 
@@ -184,69 +199,59 @@ template <typename I> // I models InputIterator<Future<void>>
 std::shared_ptr<FutureImpl<void>>
 when_all_iterator_impl(I begin, I end, when_all_iterator_tag<void>)
 {
-    auto size = std::distance(begin, end);
+    const auto size = static_cast<std::size_t>(std::distance(begin, end));
 
     auto shouldWeResolveImmediately = size == 0;
     if (shouldWeResolveImmediately) {
         return make_ready_future_impl();
     }
 
+    // Every input decrements the countdown exactly once when it is resolved, so the promise is
+    // resolved by whichever continuation brings it to zero. Rejections race on `done` instead,
+    // which guarantees that only the first error is forwarded.
     struct State {
         State(std::size_t size, std::shared_ptr<PromiseImpl<void>> p)
-            : values(size, false)
+            : remaining(size)
             , promise(std::move(p))
         {
         }
 
-        void maybe_resolve_or_reject()
+        void resolve_one()
         {
-            if (done) {
-                return;
-            }
-
-            auto areAllValuesComplete = std::all_of(
-                values.begin(), values.end(), [](const auto& value) { return value; });
-
-            if (areAllValuesComplete) {
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
                 promise->set_value();
-                done = true;
-                return;
             }
+        }
 
-            if (error != nullptr) {
+        void reject(std::exception_ptr error)
+        {
+            if (!done.exchange(true, std::memory_order_acq_rel)) {
                 promise->set_exception(error);
-                done = true;
-                return;
             }
         }
 
-        std::exception_ptr error = nullptr;
-        std::vector<bool> values;
-        std::shared_ptr<PromiseImpl<void>> promise;
-        bool done = false;
-        std::mutex mutex;
+        std::atomic<std::size_t> remaining;
+        std::atomic<bool> done{ false };
+        const std::shared_ptr<PromiseImpl<void>> promise;
     };
 
     std::shared_ptr<FutureImpl<void>> resultFuture;
     std::shared_ptr<PromiseImpl<void>> promise;
     std::tie(resultFuture, promise) = make_lazy_future_impl<void>();
 
-    auto state = std::make_shared<State>(std::distance(begin, end), std::move(promise));
+    auto state = std::make_shared<State>(size, promise);
 
-    auto index = std::size_t{ 0 };
-    std::for_each(begin, end, [&state, &index](auto future) {
+    auto inputs = std::vector<std::weak_ptr<FutureImpl<void>>>{};
+    inputs.reserve(size);
+    std::for_each(begin, end, [&state, &inputs](auto future) {
+        inputs.push_back(get_future_impl(future));
         std::move(future)
-            .then([state, index]() {
-                std::lock_guard<std::mutex> lock{ state->mutex };
-                state->values[index] = true;
-                state->maybe_resolve_or_reject();
-            })
-            .catch_error([state](auto e) {
-                std::lock_guard<std::mutex> lock{ state->mutex };
-                state->error = e;
-                state->maybe_resolve_or_reject();
-            });
-        index++;
+            .then([state]() { state->resolve_one(); })
+            .catch_error([state](auto e) { state->reject(e); });
+    });
+
+    promise->on_cancel([inputs = std::move(inputs)]() {
+        std::for_each(inputs.begin(), inputs.end(), cancel_if_alive<FutureImpl<void>>);
     });
 
     return resultFuture;
@@ -261,77 +266,74 @@ when_all_iterator_impl(I begin, I end, when_all_iterator_tag<T>)
     using FutureT = typename std::iterator_traits<I>::value_type;
     using ValueT = typename FutureT::value_type;
 
-    auto size = std::distance(begin, end);
+    const auto size = static_cast<std::size_t>(std::distance(begin, end));
 
     auto shouldWeResolveImmediatelyWithAnEmptyVector = size == 0;
     if (shouldWeResolveImmediatelyWithAnEmptyVector) {
         return make_ready_future_impl<std::vector<ValueT>>({});
     }
 
+    // The slots are preallocated and each one is written by exactly one continuation, so they
+    // need no locking. The acquire-release countdown makes all slot writes visible to the
+    // continuation that resolves the last input, which then hands the values over.
     struct State {
         State(std::size_t size, std::shared_ptr<PromiseImpl<std::vector<ValueT>>> p)
             : values(size)
+            , remaining(size)
             , promise(std::move(p))
         {
         }
 
-        void maybe_resolve_or_reject()
+        void resolve_one(std::size_t index, ValueT value)
         {
-            if (done) {
+            values[index].emplace(std::move(value));
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
                 return;
             }
 
-            auto areAllValuesComplete = std::all_of(
-                values.begin(), values.end(), [](const auto& value) { return value.has_value(); });
-
-            if (areAllValuesComplete) {
-                auto resultValues = std::vector<ValueT>{};
-                std::transform(
-                    std::make_move_iterator(values.begin()),
-                    std::make_move_iterator(values.end()),
-                    std::back_inserter(resultValues),
-                    [](std::optional<ValueT>&& value) -> ValueT { return *std::move(value); });
-                promise->set_value(std::move(resultValues));
-                done = true;
-                return;
+            auto resultValues = std::vector<ValueT>{};
+            resultValues.reserve(values.size());
+            for (auto& slot : values) {
+                resultValues.push_back(*std::move(slot));
             }
+            values.clear();
+            promise->set_value(std::move(resultValues));
+        }
 
-            if (error != nullptr) {
+        void reject(std::exception_ptr error)
+        {
+            if (!done.exchange(true, std::memory_order_acq_rel)) {
                 promise->set_exception(error);
-                done = true;
-                return;
             }
         }
 
-        std::exception_ptr error = nullptr;
         std::vector<std::optional<ValueT>> values;
-        std::shared_ptr<PromiseImpl<std::vector<ValueT>>> promise;
-        bool done = false;
-        std::mutex mutex;
+        std::atomic<std::size_t> remaining;
+        std::atomic<bool> done{ false };
+        const std::shared_ptr<PromiseImpl<std::vector<ValueT>>> promise;
     };
 
     std::shared_ptr<FutureImpl<std::vector<ValueT>>> resultFuture;
     std::shared_ptr<PromiseImpl<std::vector<ValueT>>> promise;
     std::tie(resultFuture, promise) = make_lazy_future_impl<std::vector<ValueT>>();
 
-    auto state = std::make_shared<State>(size, std::move(promise));
+    auto state = std::make_shared<State>(size, promise);
 
+    auto inputs = std::vector<std::weak_ptr<FutureImpl<ValueT>>>{};
+    inputs.reserve(size);
     auto index = std::size_t{ 0 };
-    std::for_each(begin, end, [&state, &index](auto future) {
+    std::for_each(begin, end, [&state, &inputs, &index](auto future) {
+        inputs.push_back(get_future_impl(future));
         std::move(future)
-            .then([state, index](auto value) {
-                std::lock_guard<std::mutex> lock{ state->mutex };
-                state->values[index] = std::move(value);
-                state->maybe_resolve_or_reject();
-            })
-            .catch_error([state](auto e) {
-                std::lock_guard<std::mutex> lock{ state->mutex };
-                state->error = e;
-                state->maybe_resolve_or_reject();
-            });
+            .then([state, index](ValueT value) { state->resolve_one(index, std::move(value)); })
+            .catch_error([state](auto e) { state->reject(e); });
         index++;
     });
 
+    promise->on_cancel([inputs = std::move(inputs)]() {
+        std::for_each(inputs.begin(), inputs.end(), cancel_if_alive<FutureImpl<ValueT>>);
+    });
+
     return resultFuture;
 }
 
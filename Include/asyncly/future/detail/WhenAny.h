@@ -19,7 +19,13 @@
 #pragma once
 
 #include <atomic>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
 #include <variant>
+#include <vector>
 
 #include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/utility.hpp>
@@ -39,6 +45,10 @@
 #include "asyncly/detail/TypeUtils.h"
 #include "asyncly/future/detail/Future.h"
 
+namespace asyncly {
+template <typename T> struct IndexedValue;
+} // namespace asyncly
+
 namespace asyncly::detail {
 
 template <typename T> class PromiseImpl;
@@ -115,6 +125,21 @@ std::shared_ptr<FutureImpl<when_any_return_types<Args...>>> when_any_impl(Args..
 
     auto resolver = std::make_shared<when_any_resolver<Args...>>(promise, is_set);
 
+    // nobody else can observe the inputs, so cancelling the combined future cancels all of them
+    auto weakFutures = std::make_tuple(std::weak_ptr{ get_future_impl(args) }...);
+    promise->on_cancel([weakFutures = std::move(weakFutures)]() {
+        std::apply(
+            [](const auto&... weakFuture) {
+                auto cancelIfAlive = [](const auto& weak) {
+                    if (auto future = weak.lock()) {
+                        future->cancel();
+                    }
+                };
+                (cancelIfAlive(weakFuture), ...);
+            },
+            weakFutures);
+    });
+
     boost::hana::for_each(boost::hana::make_tuple(args...), [promise, resolver, is_set](auto arg) {
         arg.then([resolver](auto... args) { return (*resolver)(args...); })
             .catch_error([promise, is_set](auto error) mutable {
@@ -126,4 +151,95 @@ std::shared_ptr<FutureImpl<when_any_return_types<Args...>>> when_any_impl(Args..
 
     return future;
 }
+
+template <typename T> struct when_any_iterator_state {
+    when_any_iterator_state(std::shared_ptr<PromiseImpl<IndexedValue<T>>> p)
+        : promise(std::move(p))
+    {
+    }
+
+    bool try_complete()
+    {
+        return !done.exchange(true, std::memory_order_acq_rel);
+    }
+
+    void cancel_except(std::size_t winner)
+    {
+        for (std::size_t i = 0; i < inputs.size(); i++) {
+            if (i == winner) {
+                continue;
+            }
+            if (auto input = inputs[i].lock()) {
+                input->cancel();
+            }
+        }
+    }
+
+    std::atomic<bool> done{ false };
+    std::vector<std::weak_ptr<FutureImpl<T>>> inputs;
+    const std::shared_ptr<PromiseImpl<IndexedValue<T>>> promise;
+};
+
+template <typename I> // I models InputIterator<Future<T>>
+std::shared_ptr<FutureImpl<IndexedValue<typename std::iterator_traits<I>::value_type::value_type>>>
+when_any_iterator_impl(I begin, I end)
+{
+    using FutureT = typename std::iterator_traits<I>::value_type;
+    using T = typename FutureT::value_type;
+    using State = when_any_iterator_state<T>;
+
+    // The inputs have to be known before the first continuation runs, because the winner is
+    // going to cancel all others.
+    auto futures = std::vector<FutureT>(begin, end);
+    if (futures.empty()) {
+        return make_exceptional_future_impl<IndexedValue<T>>(std::make_exception_ptr(
+            std::invalid_argument("when_any requires at least one future")));
+    }
+
+    std::shared_ptr<FutureImpl<IndexedValue<T>>> resultFuture;
+    std::shared_ptr<PromiseImpl<IndexedValue<T>>> promise;
+    std::tie(resultFuture, promise) = make_lazy_future_impl<IndexedValue<T>>();
+
+    auto state = std::make_shared<State>(promise);
+    state->inputs.reserve(futures.size());
+    for (auto& future : futures) {
+        state->inputs.push_back(get_future_impl(future));
+    }
+
+    promise->on_cancel([weakState = std::weak_ptr<State>{ state }]() {
+        if (auto state = weakState.lock()) {
+            state->cancel_except(std::numeric_limits<std::size_t>::max());
+        }
+    });
+
+    for (std::size_t index = 0; index < futures.size(); index++) {
+        auto onError = [state, index](std::exception_ptr e) {
+            if (state->try_complete()) {
+                state->promise->set_exception(e);
+                state->cancel_except(index);
+            }
+        };
+        if constexpr (std::is_void_v<T>) {
+            futures[index]
+                .then([state, index]() {
+                    if (state->try_complete()) {
+                        state->promise->set_value(IndexedValue<void>{ index });
+                        state->cancel_except(index);
+                    }
+                })
+                .catch_error(std::move(onError));
+        } else {
+            futures[index]
+                .then([state, index](T value) {
+                    if (state->try_complete()) {
+                        state->promise->set_value(IndexedValue<T>{ index, std::move(value) });
+                        state->cancel_except(index);
+                    }
+                })
+                .catch_error(std::move(onError));
+        }
+    }
+
+    return resultFuture;
+}
 } // namespace asyncly::detail
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "asyncly/future/detail/Future.h"
+
+namespace asyncly {
+template <typename T> struct IndexedValue;
+} // namespace asyncly
+
+namespace asyncly::detail {
+
+template <typename T> class PromiseImpl;
+template <typename T> class FutureImpl;
+
+/// Shared state of when_n. Successful inputs claim the next result slot by incrementing
+/// `claimed` and announce that the slot has been written by incrementing `written`, so the
+/// continuation completing the k-th write resolves the result. Failures are counted
+/// separately; once more inputs have failed than can be spared, the result is rejected.
+template <typename T> struct when_n_state {
+    using ResultT = std::vector<IndexedValue<T>>;
+
+    when_n_state(
+        std::size_t n,
+        std::size_t k,
+        bool cancelRemaining,
+        std::shared_ptr<PromiseImpl<ResultT>> p)
+        : required{ k }
+        , tolerableFailures{ n - k }
+        , cancelRemaining{ cancelRemaining }
+        , slots(k)
+        , promise(std::move(p))
+    {
+    }
+
+    void resolve_one(IndexedValue<T>&& value)
+    {
+        auto slot = claimed.fetch_add(1, std::memory_order_relaxed);
+        if (slot >= required) {
+            return;
+        }
+
+        slots[slot].emplace(std::move(value));
+        if (written.fetch_add(1, std::memory_order_acq_rel) + 1 != required) {
+            return;
+        }
+
+        auto results = ResultT{};
+        results.reserve(required);
+        for (auto& result : slots) {
+            results.push_back(*std::move(result));
+        }
+        slots.clear();
+        promise->set_value(std::move(results));
+        maybe_cancel_inputs();
+    }
+
+    void reject_one(std::exception_ptr error)
+    {
+        if (failed.fetch_add(1, std::memory_order_acq_rel) != tolerableFailures) {
+            return;
+        }
+
+        promise->set_exception(error);
+        maybe_cancel_inputs();
+    }
+
+    void maybe_cancel_inputs()
+    {
+        if (!cancelRemaining) {
+            return;
+        }
+        cancel_inputs();
+    }
+
+    void cancel_inputs()
+    {
+        for (auto& weakInput : inputs) {
+            if (auto input = weakInput.lock()) {
+                input->cancel();
+            }
+        }
+    }
+
+    const std::size_t required;
+    const std::size_t tolerableFailures;
+    const bool cancelRemaining;
+    std::vector<std::optional<IndexedValue<T>>> slots;
+    std::atomic<std::size_t> claimed{ 0 };
+    std::atomic<std::size_t> written{ 0 };
+    std::atomic<std::size_t> failed{ 0 };
+    std::vector<std::weak_ptr<FutureImpl<T>>> inputs;
+    const std::shared_ptr<PromiseImpl<ResultT>> promise;
+};
+
+template <typename I> // I models InputIterator<Future<T>>
+std::shared_ptr<
+    FutureImpl<std::vector<IndexedValue<typename std::iterator_traits<I>::value_type::value_type>>>>
+when_n_impl(std::size_t k, I begin, I end, bool cancelRemaining)
+{
+    using FutureT = typename std::iterator_traits<I>::value_type;
+    using T = typename FutureT::value_type;
+    using State = when_n_state<T>;
+    using ResultT = typename State::ResultT;
+
+    auto futures = std::vector<FutureT>(begin, end);
+    if (k > futures.size()) {
+        return make_exceptional_future_impl<ResultT>(std::make_exception_ptr(
+            std::invalid_argument("when_n requires at least as many futures as results")));
+    }
+    if (k == 0) {
+        return make_ready_future_impl<ResultT>(ResultT{});
+    }
+
+    std::shared_ptr<FutureImpl<ResultT>> resultFuture;
+    std::shared_ptr<PromiseImpl<ResultT>> promise;
+    std::tie(resultFuture, promise) = make_lazy_future_impl<ResultT>();
+
+    auto state = std::make_shared<State>(futures.size(), k, cancelRemaining, promise);
+    state->inputs.reserve(futures.size());
+    for (auto& future : futures) {
+        state->inputs.push_back(get_future_impl(future));
+    }
+
+    promise->on_cancel([weakState = std::weak_ptr<State>{ state }]() {
+        if (auto state = weakState.lock()) {
+            state->cancel_inputs();
+        }
+    });
+
+    for (std::size_t index = 0; index < futures.size(); index++) {
+        auto onError = [state](std::exception_ptr e) { state->reject_one(e); };
+        if constexpr (std::is_void_v<T>) {
+            futures[index]
+                .then([state, index]() { state->resolve_one(IndexedValue<void>{ index }); })
+                .catch_error(std::move(onError));
+        } else {
+            futures[index]
+                .then([state, index](T value) {
+                    state->resolve_one(IndexedValue<T>{ index, std::move(value) });
+                })
+                .catch_error(std::move(onError));
+        }
+    }
+
+    return resultFuture;
+}
+} // namespace asyncly::detail
@@ -20,8 +20,8 @@
 
 #include "IRunnableScheduler.h"
 #include "detail/BaseScheduler.h"
-#include "detail/Sleep.h"
 #include <atomic>
+#include <condition_variable>
 #include <mutex>
 
 #include "asyncly/executor/IExecutor.h"
@@ -29,9 +29,14 @@
 
 namespace asyncly {
 
+/// DefaultScheduler sleeps until the earliest pending timer is due and is woken up early when a
+/// timer with an earlier deadline is scheduled, so it does not wake up at all while idle.
+/// `timerSlack` allows timers to expire up to that much late, which lets timers with close
+/// deadlines be handled by a single wakeup. Timers scheduled with execute_at_with_slack() can
+/// add their own slack on top. Timers never expire early.
 class DefaultScheduler : public IRunnableScheduler {
   public:
-    DefaultScheduler(const clock_type::duration& timerGranularity = std::chrono::milliseconds(5));
+    DefaultScheduler(const clock_type::duration& timerSlack = clock_type::duration::zero());
 
     // IScheduler
     clock_type::time_point now() const override;
@@ -42,27 +47,47 @@ class DefaultScheduler : public IRunnableScheduler {
     std::shared_ptr<Cancelable> execute_after(
         const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&&) override;
 
+    std::shared_ptr<Cancelable> execute_at_with_slack(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& absTime,
+        const clock_type::duration& slack,
+        Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_periodically(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& firstExpiry,
+        const clock_type::duration& period,
+        CatchUpPolicy policy,
+        RepeatableTask&&) override;
+
     // IRunnableScheduler
     void run() override;
     void stop() override;
 
+  private:
+    template <typename Schedule> std::shared_ptr<Cancelable> schedule(Schedule&& schedule);
+
   private:
     BaseScheduler m_baseScheduler;
-    const clock_type::duration m_timerGranularity;
+    const clock_type::duration m_timerSlack;
     std::atomic<bool> m_running;
     std::mutex m_mutex;
+    std::condition_variable m_wakeup;
 };
 
-inline DefaultScheduler::DefaultScheduler(const clock_type::duration& timerGranularity)
+inline DefaultScheduler::DefaultScheduler(const clock_type::duration& timerSlack)
     : m_baseScheduler([]() { return clock_type::now(); })
-    , m_timerGranularity(timerGranularity)
+    , m_timerSlack(timerSlack)
     , m_running(true)
 {
 }
 
 inline void DefaultScheduler::stop()
 {
+    // the lock makes sure that run() is either not waiting yet or gets notified
+    std::unique_lock<std::mutex> lock(m_mutex);
     m_running = false;
+    m_wakeup.notify_one();
 }
 
 inline asyncly::clock_type::time_point DefaultScheduler::now() const
@@ -73,15 +98,52 @@ inline asyncly::clock_type::time_point DefaultScheduler::now() const
 inline std::shared_ptr<Cancelable> DefaultScheduler::execute_at(
     const IExecutorWPtr& executor, const clock_type::time_point& absTime, Task&& task)
 {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    return m_baseScheduler.execute_at(executor, absTime, std::move(task));
+    return execute_at_with_slack(executor, absTime, clock_type::duration::zero(), std::move(task));
 }
 
 inline std::shared_ptr<Cancelable> DefaultScheduler::execute_after(
     const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&& task)
+{
+    return execute_at(executor, now() + relTime, std::move(task));
+}
+
+inline std::shared_ptr<Cancelable> DefaultScheduler::execute_at_with_slack(
+    const IExecutorWPtr& executor,
+    const clock_type::time_point& absTime,
+    const clock_type::duration& slack,
+    Task&& task)
+{
+    return schedule([&]() {
+        return m_baseScheduler.execute_at_with_slack(executor, absTime, slack, std::move(task));
+    });
+}
+
+inline std::shared_ptr<Cancelable> DefaultScheduler::execute_periodically(
+    const IExecutorWPtr& executor,
+    const clock_type::time_point& firstExpiry,
+    const clock_type::duration& period,
+    CatchUpPolicy policy,
+    RepeatableTask&& task)
+{
+    return schedule([&]() {
+        return m_baseScheduler.execute_periodically(
+            executor, firstExpiry, period, policy, std::move(task));
+    });
+}
+
+template <typename Schedule>
+std::shared_ptr<Cancelable> DefaultScheduler::schedule(Schedule&& schedule)
 {
     std::unique_lock<std::mutex> lock(m_mutex);
-    return m_baseScheduler.execute_after(executor, relTime, std::move(task));
+    const auto isEmpty = m_baseScheduler.getQueueSize() == 0;
+    const auto nextBefore = m_baseScheduler.getNextExpiredTime(clock_type::time_point::max());
+    auto cancelable = schedule();
+    // run() only has to be woken up if it is waiting for a later deadline
+    if (isEmpty
+        || m_baseScheduler.getNextExpiredTime(clock_type::time_point::max()) < nextBefore) {
+        m_wakeup.notify_one();
+    }
+    return cancelable;
 }
 
 inline void DefaultScheduler::run()
@@ -95,7 +157,22 @@ inline void DefaultScheduler::run()
             m_baseScheduler.prepareElapse();
         }
         m_baseScheduler.elapse();
-        asyncly::this_thread::sleep_for(m_timerGranularity);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            break;
+        }
+        if (m_baseScheduler.getQueueSize() == 0) {
+            m_wakeup.wait(lock);
+        } else {
+            const auto nextExpiry
+                = m_baseScheduler.getNextExpiredTime(clock_type::time_point::max());
+            // far future deadlines would overflow with the slack added
+            const auto deadline = nextExpiry > clock_type::time_point::max() - m_timerSlack
+                ? clock_type::time_point::max()
+                : nextExpiry + m_timerSlack;
+            m_wakeup.wait_until(lock, deadline);
+        }
     }
 }
 } // namespace asyncly
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "IScheduler.h"
+#include "asyncly/ExecutorTypes.h"
 
 namespace asyncly {
 
@@ -27,5 +28,11 @@ class IRunnableScheduler : public IScheduler {
     ~IRunnableScheduler() override = default;
     virtual void run() = 0;
     virtual void stop() = 0;
+
+    /// Called by SchedulerThread before run() with the init function of its thread, schedulers
+    /// that start threads of their own run it on those as well.
+    virtual void set_thread_init_function(ThreadInitFunction /*threadInit*/)
+    {
+    }
 };
 } // namespace asyncly
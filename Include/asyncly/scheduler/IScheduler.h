@@ -22,6 +22,7 @@
 
 #include "asyncly/ExecutorTypes.h"
 #include "asyncly/task/Cancelable.h"
+#include "asyncly/task/RepeatableTask.h"
 #include "asyncly/task/Task.h"
 
 namespace asyncly {
@@ -36,5 +37,31 @@ class IScheduler {
     execute_at(const IExecutorWPtr& executor, const clock_type::time_point& absTime, Task&&) = 0;
     virtual std::shared_ptr<Cancelable>
     execute_after(const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&&) = 0;
+
+    /// Like execute_at, but the task may run up to `slack` after `absTime`. Schedulers can use
+    /// this to handle timers with overlapping windows with a single wakeup, the default
+    /// implementation ignores the slack.
+    virtual std::shared_ptr<Cancelable> execute_at_with_slack(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& absTime,
+        const clock_type::duration& /*slack*/,
+        Task&& task)
+    {
+        return execute_at(executor, absTime, std::move(task));
+    }
+
+    /// Runs `task` on `executor` at `firstExpiry` and then every `period`, on a fixed schedule
+    /// that does not drift with the lateness of single ticks, until it is cancelled. Returns
+    /// nullptr without touching `task` if the scheduler has no native support for periodic
+    /// timers, callers then have to re-post the task themselves.
+    virtual std::shared_ptr<Cancelable> execute_periodically(
+        const IExecutorWPtr& /*executor*/,
+        const clock_type::time_point& /*firstExpiry*/,
+        const clock_type::duration& /*period*/,
+        CatchUpPolicy /*policy*/,
+        RepeatableTask&& /*task*/)
+    {
+        return {};
+    }
 };
 } // namespace asyncly
@@ -41,6 +41,7 @@ inline SchedulerThread::SchedulerThread(
     ThreadInitFunction threadInit, std::shared_ptr<IRunnableScheduler> runableScheduler)
     : m_runableScheduler(std::move(runableScheduler))
 {
+    m_runableScheduler->set_thread_init_function(threadInit);
     m_timerThread = std::thread([this, init = std::move(threadInit)] {
         if (init) {
             init();
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "DefaultScheduler.h"
+#include "IRunnableScheduler.h"
+
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/task/Task.h"
+
+namespace asyncly {
+
+/// ShardedScheduler splits its timers over a number of independent DefaultSchedulers, each with
+/// its own timer queue, mutex and thread. The shard of a timer is picked by its executor, so
+/// executors in different shards do not contend on a common mutex and their expirations are spread
+/// over the shard threads.
+///
+/// Timers of the same executor always end up in the same shard, so their relative order is the
+/// same as with a single DefaultScheduler. Expired timers are still posted by the shard threads;
+/// to expire them on the worker threads of a thread pool instead, set
+/// `ThreadPoolConfig::workerTimers`.
+///
+/// run() runs the first shard on the calling thread and starts a thread for each of the others,
+/// so it can be used by a SchedulerThread like any other IRunnableScheduler. The init function of
+/// the SchedulerThread is run on the shard threads as well:
+/// \snippet ShardedSchedulerTest.cpp ShardedScheduler Factory
+///
+/// Every shard costs a thread, and a factory creates a scheduler for every thread pool, so the
+/// default number of shards is kept small.
+class ShardedScheduler : public IRunnableScheduler {
+  public:
+    static constexpr size_t kDefaultNumberOfShards = 2;
+
+    ShardedScheduler(
+        size_t numberOfShards = kDefaultNumberOfShards,
+        const clock_type::duration& timerSlack = clock_type::duration::zero());
+
+    size_t getNumberOfShards() const;
+
+    // IScheduler
+    clock_type::time_point now() const override;
+
+    std::shared_ptr<Cancelable> execute_at(
+        const IExecutorWPtr& executor, const clock_type::time_point& absTime, Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_after(
+        const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_at_with_slack(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& absTime,
+        const clock_type::duration& slack,
+        Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_periodically(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& firstExpiry,
+        const clock_type::duration& period,
+        CatchUpPolicy policy,
+        RepeatableTask&&) override;
+
+    // IRunnableScheduler
+    void run() override;
+    void stop() override;
+    void set_thread_init_function(ThreadInitFunction threadInit) override;
+
+  private:
+    DefaultScheduler& get_shard(const IExecutorWPtr& executor);
+
+  private:
+    std::vector<std::unique_ptr<DefaultScheduler>> m_shards;
+    std::mutex m_mutex;
+    std::vector<std::thread> m_shardThreads;
+    ThreadInitFunction m_threadInit;
+    bool m_running;
+};
+
+inline ShardedScheduler::ShardedScheduler(
+    size_t numberOfShards, const clock_type::duration& timerSlack)
+    : m_running(true)
+{
+    if (numberOfShards == 0) {
+        throw std::invalid_argument("ShardedScheduler needs at least one shard");
+    }
+    for (size_t i = 0; i < numberOfShards; ++i) {
+        m_shards.push_back(std::make_unique<DefaultScheduler>(timerSlack));
+    }
+}
+
+inline size_t ShardedScheduler::getNumberOfShards() const
+{
+    return m_shards.size();
+}
+
+inline clock_type::time_point ShardedScheduler::now() const
+{
+    return m_shards.front()->now();
+}
+
+inline std::shared_ptr<Cancelable> ShardedScheduler::execute_at(
+    const IExecutorWPtr& executor, const clock_type::time_point& absTime, Task&& task)
+{
+    return get_shard(executor).execute_at(executor, absTime, std::move(task));
+}
+
+inline std::shared_ptr<Cancelable> ShardedScheduler::execute_after(
+    const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&& task)
+{
+    return get_shard(executor).execute_after(executor, relTime, std::move(task));
+}
+
+inline std::shared_ptr<Cancelable> ShardedScheduler::execute_at_with_slack(
+    const IExecutorWPtr& executor,
+    const clock_type::time_point& absTime,
+    const clock_type::duration& slack,
+    Task&& task)
+{
+    return get_shard(executor).execute_at_with_slack(executor, absTime, slack, std::move(task));
+}
+
+inline std::shared_ptr<Cancelable> ShardedScheduler::execute_periodically(
+    const IExecutorWPtr& executor,
+    const clock_type::time_point& firstExpiry,
+    const clock_type::duration& period,
+    CatchUpPolicy policy,
+    RepeatableTask&& task)
+{
+    return get_shard(executor).execute_periodically(
+        executor, firstExpiry, period, policy, std::move(task));
+}
+
+inline void ShardedScheduler::run()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+        for (size_t i = 1; i < m_shards.size(); ++i) {
+            m_shardThreads.emplace_back([shard = m_shards[i].get(), init = m_threadInit]() {
+                if (init) {
+                    init();
+                }
+                shard->run();
+            });
+        }
+    }
+    m_shards.front()->run();
+
+    // stop() has been called, the other shards are stopped as well
+    for (auto& thread : m_shardThreads) {
+        thread.join();
+    }
+}
+
+inline void ShardedScheduler::stop()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_running = false;
+    for (auto& shard : m_shards) {
+        shard->stop();
+    }
+}
+
+inline void ShardedScheduler::set_thread_init_function(ThreadInitFunction threadInit)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_threadInit = std::move(threadInit);
+}
+
+inline DefaultScheduler& ShardedScheduler::get_shard(const IExecutorWPtr& executor)
+{
+    // executors are aligned, so their addresses are mixed before they are mapped to a shard
+    const auto address = reinterpret_cast<std::uintptr_t>(executor.lock().get());
+    const auto hash = static_cast<std::uint64_t>(address) * 0x9E3779B97F4A7C15u;
+    return *m_shards[(hash >> 32) % m_shards.size()];
+}
+} // namespace asyncly
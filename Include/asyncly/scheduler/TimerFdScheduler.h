@@ -0,0 +1,293 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <system_error>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "IRunnableScheduler.h"
+#include "detail/BaseScheduler.h"
+
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/task/Task.h"
+
+namespace asyncly {
+
+/// TimerFdScheduler lets the kernel wait for its timers: a timerfd is armed for the earliest
+/// pending deadline and rearmed whenever the earliest deadline changes, so there is neither a
+/// polling loop nor a wakeup while idle. Linux only.
+///
+/// The file descriptor returned by get_fd() becomes readable when timers are due, so the
+/// scheduler can be integrated into an existing event loop instead of running it in a
+/// SchedulerThread: add the fd to the loop and call runOnce() whenever it is readable.
+/// \snippet TimerFdSchedulerTest.cpp TimerFdScheduler Event Loop
+///
+/// run() does the same with its own epoll_wait loop until stop() is called.
+class TimerFdScheduler : public IRunnableScheduler {
+  public:
+    TimerFdScheduler();
+    ~TimerFdScheduler() override;
+
+    TimerFdScheduler(TimerFdScheduler const&) = delete;
+    TimerFdScheduler& operator=(TimerFdScheduler const&) = delete;
+
+    /// epoll fd which is readable while timers are due or after stop() has been called
+    int get_fd() const;
+
+    /// expires the due timers without blocking, may be called spuriously
+    void runOnce();
+
+    // IScheduler
+    clock_type::time_point now() const override;
+
+    std::shared_ptr<Cancelable> execute_at(
+        const IExecutorWPtr& executor, const clock_type::time_point& absTime, Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_after(
+        const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_at_with_slack(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& absTime,
+        const clock_type::duration& slack,
+        Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_periodically(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& firstExpiry,
+        const clock_type::duration& period,
+        CatchUpPolicy policy,
+        RepeatableTask&&) override;
+
+    // IRunnableScheduler
+    void run() override;
+    void stop() override;
+
+  private:
+    template <typename Schedule> std::shared_ptr<Cancelable> schedule(Schedule&& schedule);
+
+    // must be called with m_mutex held
+    void arm(clock_type::time_point expiry);
+    void disarm();
+    void closeFds();
+    [[noreturn]] static void throwSystemError(const char* what);
+
+  private:
+    BaseScheduler m_baseScheduler;
+    std::atomic<bool> m_running;
+    std::mutex m_mutex;
+    int m_timerFd;
+    int m_stopFd;
+    int m_epollFd;
+};
+
+inline TimerFdScheduler::TimerFdScheduler()
+    : m_baseScheduler([]() { return clock_type::now(); })
+    , m_running(true)
+    , m_timerFd(-1)
+    , m_stopFd(-1)
+    , m_epollFd(-1)
+{
+    // steady_clock is CLOCK_MONOTONIC, so its time points can be used as absolute timerfd values
+    m_timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    m_stopFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (m_timerFd < 0 || m_stopFd < 0 || m_epollFd < 0) {
+        const auto error = errno;
+        closeFds();
+        errno = error;
+        throwSystemError("TimerFdScheduler: creating file descriptors failed");
+    }
+
+    for (const auto fd : { m_timerFd, m_stopFd }) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            const auto error = errno;
+            closeFds();
+            errno = error;
+            throwSystemError("TimerFdScheduler: epoll_ctl failed");
+        }
+    }
+}
+
+inline TimerFdScheduler::~TimerFdScheduler()
+{
+    closeFds();
+}
+
+inline void TimerFdScheduler::closeFds()
+{
+    for (auto* fd : { &m_epollFd, &m_stopFd, &m_timerFd }) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+inline int TimerFdScheduler::get_fd() const
+{
+    return m_epollFd;
+}
+
+inline asyncly::clock_type::time_point TimerFdScheduler::now() const
+{
+    return m_baseScheduler.now();
+}
+
+inline std::shared_ptr<Cancelable> TimerFdScheduler::execute_at(
+    const IExecutorWPtr& executor, const clock_type::time_point& absTime, Task&& task)
+{
+    return execute_at_with_slack(executor, absTime, clock_type::duration::zero(), std::move(task));
+}
+
+inline std::shared_ptr<Cancelable> TimerFdScheduler::execute_after(
+    const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&& task)
+{
+    return execute_at(executor, now() + relTime, std::move(task));
+}
+
+inline std::shared_ptr<Cancelable> TimerFdScheduler::execute_at_with_slack(
+    const IExecutorWPtr& executor,
+    const clock_type::time_point& absTime,
+    const clock_type::duration& slack,
+    Task&& task)
+{
+    return schedule([&]() {
+        return m_baseScheduler.execute_at_with_slack(executor, absTime, slack, std::move(task));
+    });
+}
+
+inline std::shared_ptr<Cancelable> TimerFdScheduler::execute_periodically(
+    const IExecutorWPtr& executor,
+    const clock_type::time_point& firstExpiry,
+    const clock_type::duration& period,
+    CatchUpPolicy policy,
+    RepeatableTask&& task)
+{
+    return schedule([&]() {
+        return m_baseScheduler.execute_periodically(
+            executor, firstExpiry, period, policy, std::move(task));
+    });
+}
+
+template <typename Schedule>
+std::shared_ptr<Cancelable> TimerFdScheduler::schedule(Schedule&& schedule)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto isEmpty = m_baseScheduler.getQueueSize() == 0;
+    const auto nextBefore = m_baseScheduler.getNextExpiredTime(clock_type::time_point::max());
+    auto cancelable = schedule();
+    // the timerfd only has to be rearmed if the earliest deadline moved forward
+    const auto nextAfter = m_baseScheduler.getNextExpiredTime(clock_type::time_point::max());
+    if (m_baseScheduler.getQueueSize() != 0 && (isEmpty || nextAfter < nextBefore)) {
+        arm(nextAfter);
+    }
+    return cancelable;
+}
+
+inline void TimerFdScheduler::runOnce()
+{
+    std::uint64_t expirations;
+    while (::read(m_timerFd, &expirations, sizeof(expirations)) < 0 && errno == EINTR) {
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_baseScheduler.prepareElapse();
+    }
+    m_baseScheduler.elapse();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_baseScheduler.getQueueSize() == 0) {
+        disarm();
+    } else {
+        arm(m_baseScheduler.getNextExpiredTime(clock_type::time_point::max()));
+    }
+}
+
+inline void TimerFdScheduler::run()
+{
+    epoll_event events[2];
+    while (m_running) {
+        if (::epoll_wait(m_epollFd, events, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwSystemError("TimerFdScheduler: epoll_wait failed");
+        }
+        if (!m_running) {
+            break;
+        }
+        runOnce();
+    }
+}
+
+inline void TimerFdScheduler::stop()
+{
+    m_running = false;
+    // the eventfd is never read, so it keeps epoll_wait() from blocking from now on
+    const std::uint64_t one = 1;
+    while (::write(m_stopFd, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+}
+
+inline void TimerFdScheduler::arm(clock_type::time_point expiry)
+{
+    const auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::max(expiry, clock_type::time_point{}).time_since_epoch());
+    itimerspec spec{};
+    spec.it_value.tv_sec = static_cast<time_t>(sinceEpoch.count() / 1000000000);
+    spec.it_value.tv_nsec = static_cast<long>(sinceEpoch.count() % 1000000000);
+    if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+        // a zero value would disarm the timer, one nanosecond after boot is due just the same
+        spec.it_value.tv_nsec = 1;
+    }
+    if (::timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0) {
+        throwSystemError("TimerFdScheduler: timerfd_settime failed");
+    }
+}
+
+inline void TimerFdScheduler::throwSystemError(const char* what)
+{
+    throw std::system_error(errno, std::system_category(), what);
+}
+
+inline void TimerFdScheduler::disarm()
+{
+    const itimerspec spec{};
+    ::timerfd_settime(m_timerFd, 0, &spec, nullptr);
+}
+} // namespace asyncly
+
+#endif
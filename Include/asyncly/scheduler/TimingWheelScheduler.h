@@ -0,0 +1,109 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include "IRunnableScheduler.h"
+#include "detail/TimingWheel.h"
+
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/task/Task.h"
+
+namespace asyncly {
+
+/// TimingWheelScheduler is an IRunnableScheduler for large numbers of outstanding timers. Timers
+/// are kept in a hierarchical timing wheel, so scheduling and cancelling one is O(1) regardless
+/// of how many are pending, and cancelled timers are removed right away. Deadlines are rounded up
+/// to multiples of `resolution`, so timers expire up to one `resolution` late but never early.
+/// run() only wakes up when a timer expires or has to be moved down a level of the wheel, and
+/// not at all while no timers are pending.
+///
+/// Use it instead of the DefaultScheduler of an executor controller by setting
+/// `ThreadPoolConfig::schedulerFactory` or `ThreadConfig::schedulerFactory`:
+/// \snippet TimingWheelSchedulerTest.cpp TimingWheelScheduler Factory
+class TimingWheelScheduler : public IRunnableScheduler {
+  public:
+    TimingWheelScheduler(const clock_type::duration& resolution = std::chrono::milliseconds(1));
+    ~TimingWheelScheduler() override;
+
+    // number of pending timers
+    size_t getQueueSize() const;
+
+    // IScheduler
+    clock_type::time_point now() const override;
+
+    std::shared_ptr<Cancelable> execute_at(
+        const IExecutorWPtr& executor, const clock_type::time_point& absTime, Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_after(
+        const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&&) override;
+
+    // IRunnableScheduler
+    void run() override;
+    void stop() override;
+
+  private:
+    const std::shared_ptr<detail::TimingWheel> m_wheel;
+};
+
+inline TimingWheelScheduler::TimingWheelScheduler(const clock_type::duration& resolution)
+    : m_wheel(std::make_shared<detail::TimingWheel>(resolution, []() { return clock_type::now(); }))
+{
+}
+
+inline TimingWheelScheduler::~TimingWheelScheduler()
+{
+    m_wheel->clear();
+}
+
+inline size_t TimingWheelScheduler::getQueueSize() const
+{
+    return m_wheel->size();
+}
+
+inline clock_type::time_point TimingWheelScheduler::now() const
+{
+    return m_wheel->now();
+}
+
+inline std::shared_ptr<Cancelable> TimingWheelScheduler::execute_at(
+    const IExecutorWPtr& executor, const clock_type::time_point& absTime, Task&& task)
+{
+    return m_wheel->add(executor, absTime, std::move(task));
+}
+
+inline std::shared_ptr<Cancelable> TimingWheelScheduler::execute_after(
+    const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&& task)
+{
+    return m_wheel->add(executor, m_wheel->now() + relTime, std::move(task));
+}
+
+inline void TimingWheelScheduler::run()
+{
+    m_wheel->run();
+}
+
+inline void TimingWheelScheduler::stop()
+{
+    m_wheel->stop();
+}
+} // namespace asyncly
@@ -18,13 +18,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <memory>
 #include <queue>
+#include <vector>
 
-#include "asyncly/executor/ExecutorStoppedException.h"
 #include "asyncly/executor/IExecutor.h"
 #include "asyncly/scheduler/IScheduler.h"
-#include "asyncly/scheduler/PriorityQueue.h"
-#include "asyncly/task/CancelableTask.h"
+#include "asyncly/scheduler/detail/TimerQueue.h"
 #include "asyncly/task/Task.h"
 
 namespace asyncly {
@@ -41,6 +42,10 @@ class BaseScheduler : public IScheduler {
 
     size_t elapse();
 
+    /**
+     * Returns the number of pending timers. Cancelled timers are removed from the queue right
+     * away and are not counted.
+     */
     size_t getQueueSize() const;
     /**
      * Return the time_point of the next scheduled tasks, if it is older or equal than limit.
@@ -63,26 +68,29 @@ class BaseScheduler : public IScheduler {
     std::shared_ptr<Cancelable> execute_after(
         const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&&) override;
 
-  private:
-    struct TimerQueueElementCompare;
-    using TimerQueueElement = std::pair<clock_type::time_point, Task>;
-    using TimerQueue = detail::
-        PriorityQueue<TimerQueueElement, std::vector<TimerQueueElement>, TimerQueueElementCompare>;
-
-    struct TimerQueueElementCompare {
-        bool operator()(const TimerQueueElement& a, const TimerQueueElement& b)
-        {
-            return a.first > b.first;
-        }
-    };
+    std::shared_ptr<Cancelable> execute_at_with_slack(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& absTime,
+        const clock_type::duration& slack,
+        Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_periodically(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& firstExpiry,
+        const clock_type::duration& period,
+        CatchUpPolicy policy,
+        RepeatableTask&&) override;
 
-    TimerQueue m_timerQueue;
-    std::queue<Task> m_elapsedQueue;
+  private:
+    // shared with the cancelables of the timers, which remove themselves when cancelled
+    const std::shared_ptr<detail::TimerQueue> m_timerQueue;
+    std::queue<std::shared_ptr<detail::QueuedTimer>> m_elapsedQueue;
     ClockNowFunction m_now;
 };
 
 inline BaseScheduler::BaseScheduler(const ClockNowFunction& nowFunction)
-    : m_now(nowFunction)
+    : m_timerQueue(std::make_shared<detail::TimerQueue>())
+    , m_now(nowFunction)
 {
 }
 
@@ -94,20 +102,30 @@ inline asyncly::clock_type::time_point BaseScheduler::now() const
 inline std::shared_ptr<Cancelable> BaseScheduler::execute_at(
     const IExecutorWPtr& executor, const clock_type::time_point& absTime, Task&& task)
 {
-    auto sharedTask = std::make_shared<Task>(std::move(task));
-    auto cancelable = std::make_shared<TaskCancelable>(sharedTask);
-    Task cancelableTask(CancelableTask(sharedTask, cancelable));
-
-    m_timerQueue.push({ absTime, [executor, cancelableTask{ std::move(cancelableTask) }]() mutable {
-                           if (auto p = executor.lock()) {
-                               try {
-                                   p->post(std::move(cancelableTask));
-                               } catch (const ExecutorStoppedException&) {
-                                   // ignore
-                               }
-                           }
-                       } });
-    return cancelable;
+    return m_timerQueue->push(executor, absTime, clock_type::duration::zero(), std::move(task));
+}
+
+inline std::shared_ptr<Cancelable> BaseScheduler::execute_at_with_slack(
+    const IExecutorWPtr& executor,
+    const clock_type::time_point& absTime,
+    const clock_type::duration& slack,
+    Task&& task)
+{
+    return m_timerQueue->push(executor, absTime, slack, std::move(task));
+}
+
+inline std::shared_ptr<Cancelable> BaseScheduler::execute_periodically(
+    const IExecutorWPtr& executor,
+    const clock_type::time_point& firstExpiry,
+    const clock_type::duration& period,
+    CatchUpPolicy policy,
+    RepeatableTask&& task)
+{
+    if (period <= clock_type::duration::zero()) {
+        // there is no schedule to stay on, the caller re-posts the task
+        return {};
+    }
+    return m_timerQueue->pushPeriodic(executor, firstExpiry, period, policy, std::move(task));
 }
 
 inline std::shared_ptr<Cancelable> BaseScheduler::execute_after(
@@ -118,34 +136,50 @@ inline std::shared_ptr<Cancelable> BaseScheduler::execute_after(
 
 inline void BaseScheduler::prepareElapse()
 {
-    const auto now = m_now();
-    while (!m_timerQueue.empty() && m_timerQueue.peek().first <= now) {
-        m_elapsedQueue.push(std::move(m_timerQueue.pop().second));
-    }
+    m_timerQueue->popExpired(m_now(), m_elapsedQueue);
 }
 
 inline size_t BaseScheduler::elapse()
 {
     const auto elapsedTasks = m_elapsedQueue.size();
+    // timers with slack are posted in one task per executor, the others one by one
+    std::vector<std::vector<std::shared_ptr<detail::QueuedTimer>>> batches;
     while (!m_elapsedQueue.empty()) {
-        auto task = std::move(m_elapsedQueue.front());
+        auto timer = std::move(m_elapsedQueue.front());
         m_elapsedQueue.pop();
-        task();
+        if (!timer->hasSlack()) {
+            timer->post();
+            continue;
+        }
+        const auto batch = std::find_if(batches.begin(), batches.end(), [&timer](const auto& b) {
+            const auto& executor = b.front()->executor();
+            return !executor.owner_before(timer->executor())
+                && !timer->executor().owner_before(executor);
+        });
+        if (batch == batches.end()) {
+            batches.push_back({ std::move(timer) });
+        } else {
+            batch->push_back(std::move(timer));
+        }
+    }
+    for (auto& batch : batches) {
+        detail::QueuedTimer::post(std::move(batch));
     }
     return elapsedTasks;
 }
 inline size_t BaseScheduler::getQueueSize() const
 {
-    return m_timerQueue.size();
+    return m_timerQueue->size();
 }
 
 inline clock_type::time_point BaseScheduler::getNextExpiredTime(clock_type::time_point limit) const
 {
     const auto now = m_now();
-    if (m_timerQueue.empty()) {
+    const auto next = m_timerQueue->front();
+    if (!next) {
         return std::max(limit, now);
-    } else if (m_timerQueue.peek().first <= limit) {
-        return std::max(m_timerQueue.peek().first, now);
+    } else if (*next <= limit) {
+        return std::max(*next, now);
     } else {
         return std::max(limit, now);
     }
@@ -154,8 +188,8 @@ inline clock_type::time_point BaseScheduler::getNextExpiredTime(clock_type::time
 inline clock_type::time_point BaseScheduler::getLastExpiredTime() const
 {
     const auto now = m_now();
-    if (!m_timerQueue.empty()) {
-        return std::max(m_timerQueue.peekBack().first, now);
+    if (const auto last = m_timerQueue->back()) {
+        return std::max(*last, now);
     } else {
         return now;
     }
@@ -163,7 +197,7 @@ inline clock_type::time_point BaseScheduler::getLastExpiredTime() const
 
 inline void BaseScheduler::clear()
 {
-    m_timerQueue.clear();
+    m_timerQueue->clear();
     while (!m_elapsedQueue.empty()) {
         m_elapsedQueue.pop();
     }
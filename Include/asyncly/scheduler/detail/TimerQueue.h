@@ -0,0 +1,430 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "asyncly/ExecutorTypes.h"
+#include "asyncly/executor/ExecutorStoppedException.h"
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/task/Cancelable.h"
+#include "asyncly/task/RepeatableTask.h"
+#include "asyncly/task/Task.h"
+
+namespace asyncly::detail {
+
+class TimerQueue;
+
+/// A timer of a TimerQueue. It holds everything needed to run the task and is also the Cancelable
+/// returned to the caller, so scheduling a timer costs a single allocation. Cancelling it removes
+/// it from the queue right away instead of leaving it there until its deadline.
+///
+/// A periodic timer stays in the queue, which moves it to its next tick in place when it expires,
+/// so its ticks do not allocate timers or closures again.
+class QueuedTimer : public Cancelable, public std::enable_shared_from_this<QueuedTimer> {
+  public:
+    QueuedTimer(
+        IExecutorWPtr executor, Task&& task, bool hasSlack, std::weak_ptr<TimerQueue> queue)
+        : executor_(std::move(executor))
+        , task_(std::move(task))
+        , hasSlack_(hasSlack)
+        , queue_(std::move(queue))
+    {
+    }
+
+    QueuedTimer(
+        IExecutorWPtr executor,
+        clock_type::duration period,
+        CatchUpPolicy policy,
+        RepeatableTask&& task,
+        std::weak_ptr<TimerQueue> queue)
+        : executor_(std::move(executor))
+        , periodic_(std::make_unique<Periodic>(period, policy, std::move(task)))
+        , hasSlack_(false)
+        , queue_(std::move(queue))
+    {
+    }
+
+    bool cancel() override;
+
+    const IExecutorWPtr& executor() const
+    {
+        return executor_;
+    }
+
+    // timers with slack tolerate being run together with other timers of their executor
+    bool hasSlack() const
+    {
+        return hasSlack_;
+    }
+
+    // runs the task unless the timer has been cancelled in the meantime, to be called on the
+    // executor
+    void run()
+    {
+        if (periodic_) {
+            // ticks that expire while this runs are posted again
+            auto runs = periodic_->pendingRuns.exchange(0);
+            // the copy keeps the task alive while it runs, even if it is cancelled meanwhile
+            const auto task = periodic_->getTask();
+            for (; task && runs > 0 && state_ == State::Pending; runs--) {
+                (*task)();
+            }
+            return;
+        }
+        auto expected = State::Pending;
+        if (state_.compare_exchange_strong(expected, State::Running)) {
+            (*task_)();
+        }
+    }
+
+    // posts the task to its executor, where it runs unless it is cancelled in the meantime
+    void post()
+    {
+        auto executor = executor_.lock();
+        if (!executor) {
+            if (periodic_) {
+                cancel();
+            }
+            return;
+        }
+        if (periodic_ && !addPendingRuns()) {
+            return;
+        }
+        try {
+            executor->post([self = shared_from_this()]() { self->run(); });
+        } catch (const ExecutorStoppedException&) {
+            // ignore
+        }
+    }
+
+    // posts timers of the same executor to it as a single task
+    static void post(std::vector<std::shared_ptr<QueuedTimer>>&& timers)
+    {
+        auto executor = timers.front()->executor_.lock();
+        if (!executor) {
+            return;
+        }
+        try {
+            executor->post([timers = std::move(timers)]() {
+                for (const auto& timer : timers) {
+                    timer->run();
+                }
+            });
+        } catch (const ExecutorStoppedException&) {
+            // ignore
+        }
+    }
+
+  private:
+    friend class TimerQueue;
+
+    enum class State { Pending, Running, Cancelled };
+
+    struct Periodic {
+        Periodic(clock_type::duration p, CatchUpPolicy c, RepeatableTask&& t)
+            : period(p)
+            , policy(c)
+            , task(std::make_shared<RepeatableTask>(std::move(t)))
+        {
+        }
+
+        std::shared_ptr<RepeatableTask> getTask()
+        {
+            std::lock_guard<std::mutex> lock{ taskMutex };
+            return task;
+        }
+
+        std::shared_ptr<RepeatableTask> releaseTask()
+        {
+            std::lock_guard<std::mutex> lock{ taskMutex };
+            return std::move(task);
+        }
+
+        const clock_type::duration period;
+        const CatchUpPolicy policy;
+        // empty once the timer is cancelled
+        std::mutex taskMutex;
+        std::shared_ptr<RepeatableTask> task;
+        // runs due according to the policy, added by the queue and taken by post()
+        std::atomic<std::size_t> dueRuns{ 0 };
+        // runs posted to the executor which have not started yet
+        std::atomic<std::size_t> pendingRuns{ 0 };
+    };
+
+    // moves the due runs to the pending ones, returns false if a posted run takes care of them
+    bool addPendingRuns()
+    {
+        const auto due = periodic_->dueRuns.exchange(0);
+        if (due == 0) {
+            return false;
+        }
+        const auto pending = periodic_->policy == CatchUpPolicy::Burst
+            ? periodic_->pendingRuns.fetch_add(due)
+            : periodic_->pendingRuns.exchange(1);
+        return pending == 0;
+    }
+
+    static constexpr std::size_t kNotQueued = std::numeric_limits<std::size_t>::max();
+
+    const IExecutorWPtr executor_;
+    // exactly one of them is set
+    std::optional<Task> task_;
+    const std::unique_ptr<Periodic> periodic_;
+    const bool hasSlack_;
+    std::atomic<State> state_{ State::Pending };
+    const std::weak_ptr<TimerQueue> queue_;
+    // position in the heap of the queue, protected by the mutex of the queue
+    std::size_t index_ = kNotQueued;
+};
+
+/// Thread safe min heap of timers, which keeps track of the position of every timer so that a
+/// cancelled timer can be removed in O(log n). Timers are never destroyed while the mutex is held,
+/// as the destructors of their tasks might schedule or cancel other timers.
+///
+/// Every timer has a window from its earliest to its latest expiry, which only differ for timers
+/// with slack. The heap is ordered by the latest expiry, which is when the queue has to be
+/// serviced at the latest, and servicing it expires every timer at the front whose window has
+/// started. So timers with overlapping windows expire together, but never early.
+class TimerQueue : public std::enable_shared_from_this<TimerQueue> {
+  public:
+    std::shared_ptr<QueuedTimer> push(
+        const IExecutorWPtr& executor,
+        clock_type::time_point expiry,
+        clock_type::duration slack,
+        Task&& task)
+    {
+        const auto hasSlack = slack > clock_type::duration::zero();
+        auto timer = std::make_shared<QueuedTimer>(
+            executor, std::move(task), hasSlack, weak_from_this());
+        const auto latest = hasSlack && expiry < clock_type::time_point::max() - slack
+            ? expiry + slack
+            : expiry;
+        std::lock_guard<std::mutex> lock(mutex_);
+        timer->index_ = timers_.size();
+        timers_.push_back({ expiry, latest, timer });
+        siftUp(timers_.size() - 1);
+        return timer;
+    }
+
+    std::shared_ptr<QueuedTimer> pushPeriodic(
+        const IExecutorWPtr& executor,
+        clock_type::time_point firstExpiry,
+        clock_type::duration period,
+        CatchUpPolicy policy,
+        RepeatableTask&& task)
+    {
+        auto timer = std::make_shared<QueuedTimer>(
+            executor, period, policy, std::move(task), weak_from_this());
+        std::lock_guard<std::mutex> lock(mutex_);
+        timer->index_ = timers_.size();
+        timers_.push_back({ firstExpiry, firstExpiry, timer });
+        siftUp(timers_.size() - 1);
+        return timer;
+    }
+
+    // moves the timers due at `now` into `expired`, in order of their latest expiry. Periodic
+    // timers stay in the queue and are moved to their next tick.
+    void popExpired(clock_type::time_point now, std::queue<std::shared_ptr<QueuedTimer>>& expired)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!timers_.empty() && timers_.front().earliest <= now) {
+            if (timers_.front().timer->periodic_) {
+                expired.push(timers_.front().timer);
+                advance(now);
+            } else {
+                expired.push(removeAt(0));
+            }
+        }
+    }
+
+    void remove(QueuedTimer& timer)
+    {
+        std::shared_ptr<QueuedTimer> removed;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (timer.index_ == QueuedTimer::kNotQueued) {
+                return;
+            }
+            removed = removeAt(timer.index_);
+        }
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return timers_.size();
+    }
+
+    // time at which the queue has to be serviced next
+    std::optional<clock_type::time_point> front() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (timers_.empty()) {
+            return {};
+        }
+        return timers_.front().latest;
+    }
+
+    // time at which all timers will have expired
+    std::optional<clock_type::time_point> back() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (timers_.empty()) {
+            return {};
+        }
+        return std::max_element(
+                   timers_.begin(),
+                   timers_.end(),
+                   [](const Entry& a, const Entry& b) { return a.latest < b.latest; })
+            ->latest;
+    }
+
+    void clear()
+    {
+        std::vector<Entry> timers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& entry : timers_) {
+                entry.timer->index_ = QueuedTimer::kNotQueued;
+            }
+            timers.swap(timers_);
+        }
+    }
+
+  private:
+    // the expiries are kept next to the pointer so that comparisons do not dereference it
+    struct Entry {
+        clock_type::time_point earliest;
+        clock_type::time_point latest;
+        std::shared_ptr<QueuedTimer> timer;
+    };
+
+    // moves the periodic timer at the front to its first tick after `now`
+    void advance(clock_type::time_point now)
+    {
+        auto& entry = timers_.front();
+        auto& periodic = *entry.timer->periodic_;
+        // expiries are computed from the first one, so late ticks do not shift later ones
+        const auto ticks = static_cast<std::size_t>((now - entry.earliest) / periodic.period) + 1;
+        entry.earliest += periodic.period * ticks;
+        entry.latest = entry.earliest;
+        switch (periodic.policy) {
+        case CatchUpPolicy::Burst:
+            periodic.dueRuns += ticks;
+            break;
+        case CatchUpPolicy::Skip:
+            periodic.dueRuns += ticks == 1 ? 1 : 0;
+            break;
+        case CatchUpPolicy::Coalesce:
+            periodic.dueRuns += 1;
+            break;
+        }
+        siftDown(0);
+    }
+
+    std::shared_ptr<QueuedTimer> removeAt(std::size_t index)
+    {
+        auto removed = std::move(timers_[index].timer);
+        removed->index_ = QueuedTimer::kNotQueued;
+        const auto last = timers_.size() - 1;
+        if (index != last) {
+            place(index, std::move(timers_[last]));
+            timers_.pop_back();
+            siftDown(index);
+            siftUp(index);
+        } else {
+            timers_.pop_back();
+        }
+        return removed;
+    }
+
+    void siftUp(std::size_t index)
+    {
+        auto entry = std::move(timers_[index]);
+        while (index > 0) {
+            const auto parent = (index - 1) / 2;
+            if (!(entry.latest < timers_[parent].latest)) {
+                break;
+            }
+            place(index, std::move(timers_[parent]));
+            index = parent;
+        }
+        place(index, std::move(entry));
+    }
+
+    void siftDown(std::size_t index)
+    {
+        auto entry = std::move(timers_[index]);
+        const auto size = timers_.size();
+        while (true) {
+            auto child = 2 * index + 1;
+            if (child >= size) {
+                break;
+            }
+            if (child + 1 < size && timers_[child + 1].latest < timers_[child].latest) {
+                child++;
+            }
+            if (!(timers_[child].latest < entry.latest)) {
+                break;
+            }
+            place(index, std::move(timers_[child]));
+            index = child;
+        }
+        place(index, std::move(entry));
+    }
+
+    void place(std::size_t index, Entry&& entry)
+    {
+        entry.timer->index_ = index;
+        timers_[index] = std::move(entry);
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<Entry> timers_;
+};
+
+inline bool QueuedTimer::cancel()
+{
+    auto expected = State::Pending;
+    if (!state_.compare_exchange_strong(expected, State::Cancelled)) {
+        return false;
+    }
+    if (auto queue = queue_.lock()) {
+        queue->remove(*this);
+    }
+    // release the payload right away, the timer itself lives as long as the returned Cancelable.
+    // The task of a periodic timer may still be running, it is then released once it returns.
+    if (task_) {
+        task_->reset();
+    } else {
+        periodic_->releaseTask();
+    }
+    return true;
+}
+} // namespace asyncly::detail
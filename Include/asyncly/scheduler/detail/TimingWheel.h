@@ -0,0 +1,382 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "asyncly/ExecutorTypes.h"
+#include "asyncly/executor/ExecutorStoppedException.h"
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/scheduler/IScheduler.h"
+#include "asyncly/task/Cancelable.h"
+#include "asyncly/task/Task.h"
+
+namespace asyncly::detail {
+
+class TimingWheel;
+
+/// A single timer of a TimingWheel. It is linked into exactly one slot of the wheel while it is
+/// pending and keeps itself alive through `self_` during that time, so that inserting and
+/// cancelling it only relinks pointers.
+class TimingWheelTimer : public Cancelable {
+  public:
+    TimingWheelTimer(std::weak_ptr<TimingWheel> wheel, IExecutorWPtr executor, Task&& task)
+        : wheel_{ std::move(wheel) }
+        , executor_{ std::move(executor) }
+        , task_{ std::move(task) }
+    {
+    }
+
+    bool cancel() override;
+
+    // runs the task unless the timer has been cancelled in the meantime
+    void run()
+    {
+        auto expected = State::Pending;
+        if (state_.compare_exchange_strong(expected, State::Running)) {
+            task_();
+        }
+    }
+
+  private:
+    friend class TimingWheel;
+
+    enum class State { Pending, Running, Cancelled };
+
+    const std::weak_ptr<TimingWheel> wheel_;
+    const IExecutorWPtr executor_;
+    Task task_;
+    std::atomic<State> state_{ State::Pending };
+
+    // the members below are protected by the mutex of the wheel
+    std::uint64_t expiry_ = 0;
+    TimingWheelTimer* prev_ = nullptr;
+    TimingWheelTimer* next_ = nullptr;
+    TimingWheelTimer** slot_ = nullptr;
+    std::shared_ptr<TimingWheelTimer> self_;
+};
+
+/// Hierarchical timing wheel with `kLevels` levels of `kSlots` slots each. A timer due in `d`
+/// ticks is stored on the lowest level whose slots cover `d`, and moved down a level whenever the
+/// level below has completed a full rotation. Inserting and cancelling a timer is O(1), advancing
+/// the wheel is O(1) per tick plus the cost of moving the timers that are due soon.
+class TimingWheel : public std::enable_shared_from_this<TimingWheel> {
+  public:
+    static constexpr unsigned kSlotBits = 8;
+    static constexpr std::size_t kSlots = std::size_t{ 1 } << kSlotBits;
+    static constexpr unsigned kLevels = 4;
+
+    TimingWheel(clock_type::duration resolution, ClockNowFunction now)
+        : resolution_{ resolution }
+        , now_{ std::move(now) }
+        , epoch_{ now_() }
+    {
+        if (resolution_ <= clock_type::duration::zero()) {
+            throw std::invalid_argument("timing wheel resolution has to be positive");
+        }
+    }
+
+    ~TimingWheel()
+    {
+        clear();
+    }
+
+    clock_type::time_point now() const
+    {
+        return now_();
+    }
+
+    std::shared_ptr<Cancelable>
+    add(const IExecutorWPtr& executor, const clock_type::time_point& absTime, Task&& task)
+    {
+        auto timer
+            = std::make_shared<TimingWheelTimer>(weak_from_this(), executor, std::move(task));
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            if (count_ == 0) {
+                // nothing to move while the wheel was empty, so it can simply jump to now
+                current_ = std::max(current_, tick_of(now_()));
+            }
+            timer->expiry_ = deadline_tick(absTime);
+            timer->self_ = timer;
+            link_locked(*timer, current_ + 1);
+            // run() only has to wake up earlier if the timer expires before it would anyway
+            if (++count_ == 1 || std::max(timer->expiry_, current_ + 1) < wakeupTick_) {
+                wakeup_.notify_one();
+            }
+        }
+        return timer;
+    }
+
+    // returns the timer if it was still linked, so that it is destroyed outside of the lock
+    std::shared_ptr<TimingWheelTimer> remove(TimingWheelTimer& timer)
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        if (!timer.self_) {
+            return {};
+        }
+        unlink_locked(timer);
+        count_--;
+        return std::move(timer.self_);
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        return count_;
+    }
+
+    void clear()
+    {
+        std::vector<std::shared_ptr<TimingWheelTimer>> timers;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            for (auto& level : slots_) {
+                for (auto& slot : level) {
+                    while (slot) {
+                        auto& timer = *slot;
+                        unlink_locked(timer);
+                        timers.push_back(std::move(timer.self_));
+                    }
+                }
+            }
+            count_ = 0;
+        }
+    }
+
+    // moves the wheel to now and posts the expired timers, returns their number
+    std::size_t elapse()
+    {
+        std::vector<std::shared_ptr<TimingWheelTimer>> expired;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            expired = advance_locked(tick_of(now_()));
+        }
+        post(expired);
+        return expired.size();
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        while (running_) {
+            if (count_ == 0) {
+                wakeup_.wait(lock, [this]() { return !running_ || count_ > 0; });
+                continue;
+            }
+
+            auto expired = advance_locked(tick_of(now_()));
+            if (!expired.empty()) {
+                lock.unlock();
+                post(expired);
+                expired.clear();
+                lock.lock();
+                continue;
+            }
+            // sleeps until the next timer expires or has to be moved down a level
+            wakeupTick_ = next_event_locked();
+            wakeup_.wait_until(lock, time_of(wakeupTick_));
+            wakeupTick_ = 0;
+        }
+    }
+
+    void stop()
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        running_ = false;
+        wakeup_.notify_all();
+    }
+
+  private:
+    std::uint64_t tick_of(clock_type::time_point time) const
+    {
+        if (time <= epoch_) {
+            return 0;
+        }
+        return static_cast<std::uint64_t>((time - epoch_) / resolution_);
+    }
+
+    // rounds up, so that timers never expire early
+    std::uint64_t deadline_tick(clock_type::time_point time) const
+    {
+        if (time <= epoch_) {
+            return 0;
+        }
+        const auto offset = time - epoch_;
+        const auto ticks = static_cast<std::uint64_t>(offset / resolution_);
+        return offset % resolution_ == clock_type::duration::zero() ? ticks : ticks + 1;
+    }
+
+    // saturates at time_point::max() instead of overflowing
+    clock_type::time_point time_of(std::uint64_t tick) const
+    {
+        const auto maxTick = (clock_type::time_point::max() - epoch_) / resolution_;
+        if (tick >= static_cast<std::uint64_t>(maxTick)) {
+            return clock_type::time_point::max();
+        }
+        return epoch_ + resolution_ * static_cast<clock_type::rep>(tick);
+    }
+
+    // the first tick after `current_` that drains a non-empty slot of level 0 or moves a
+    // non-empty slot of a higher level down, nothing happens on the ticks before
+    std::uint64_t next_event_locked() const
+    {
+        auto next = std::numeric_limits<std::uint64_t>::max();
+        if (count_ == 0) {
+            return next;
+        }
+        for (unsigned level = 0; level < kLevels; level++) {
+            const auto shift = kSlotBits * level;
+            const auto step = std::uint64_t{ 1 } << shift;
+            auto tick = (current_ / step + 1) * step;
+            for (std::size_t i = 0; i < kSlots && tick < next; i++, tick += step) {
+                if (slots_[level][(tick >> shift) & (kSlots - 1)]) {
+                    next = tick;
+                }
+            }
+        }
+        return next;
+    }
+
+    // `earliest` is the first tick whose slot has not been processed yet, timers that are already
+    // due go there
+    void link_locked(TimingWheelTimer& timer, std::uint64_t earliest)
+    {
+        const auto expiry = std::max(timer.expiry_, earliest);
+        const auto delta = expiry - current_;
+
+        unsigned level = 0;
+        while (level + 1 < kLevels && delta >= (std::uint64_t{ 1 } << (kSlotBits * (level + 1)))) {
+            level++;
+        }
+        // timers beyond the range of the top level wait in its last slot and are moved again
+        const auto range = std::uint64_t{ 1 } << (kSlotBits * kLevels);
+        const auto placed = delta < range ? expiry : current_ + range - 1;
+        auto& head = slots_[level][(placed >> (kSlotBits * level)) & (kSlots - 1)];
+
+        timer.prev_ = nullptr;
+        timer.next_ = head;
+        if (head) {
+            head->prev_ = &timer;
+        }
+        head = &timer;
+        timer.slot_ = &head;
+    }
+
+    void unlink_locked(TimingWheelTimer& timer)
+    {
+        if (timer.prev_) {
+            timer.prev_->next_ = timer.next_;
+        } else {
+            *timer.slot_ = timer.next_;
+        }
+        if (timer.next_) {
+            timer.next_->prev_ = timer.prev_;
+        }
+        timer.prev_ = nullptr;
+        timer.next_ = nullptr;
+        timer.slot_ = nullptr;
+    }
+
+    std::vector<std::shared_ptr<TimingWheelTimer>> advance_locked(std::uint64_t target)
+    {
+        std::vector<std::shared_ptr<TimingWheelTimer>> expired;
+        while (current_ < target) {
+            // skips the ticks on which nothing happens
+            current_ = std::min(target, next_event_locked());
+
+            // every time a level has completed a rotation, the next slot of the level above is
+            // distributed over the levels below
+            for (unsigned level = 1; level < kLevels; level++) {
+                if ((current_ & ((std::uint64_t{ 1 } << (kSlotBits * level)) - 1)) != 0) {
+                    break;
+                }
+                auto& head = slots_[level][(current_ >> (kSlotBits * level)) & (kSlots - 1)];
+                auto timer = head;
+                head = nullptr;
+                while (timer) {
+                    auto next = timer->next_;
+                    link_locked(*timer, current_);
+                    timer = next;
+                }
+            }
+
+            auto& head = slots_[0][current_ & (kSlots - 1)];
+            while (head) {
+                auto& timer = *head;
+                unlink_locked(timer);
+                count_--;
+                expired.push_back(std::move(timer.self_));
+            }
+        }
+        return expired;
+    }
+
+    static void post(const std::vector<std::shared_ptr<TimingWheelTimer>>& expired)
+    {
+        for (const auto& timer : expired) {
+            if (auto executor = timer->executor_.lock()) {
+                try {
+                    executor->post([timer]() { timer->run(); });
+                } catch (const ExecutorStoppedException&) {
+                    // ignore
+                }
+            }
+        }
+    }
+
+    const clock_type::duration resolution_;
+    const ClockNowFunction now_;
+    const clock_type::time_point epoch_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool running_ = true;
+    // the tick run() sleeps until, 0 while it does not wait for a timer
+    std::uint64_t wakeupTick_ = 0;
+    std::uint64_t current_ = 0;
+    std::size_t count_ = 0;
+    std::array<std::array<TimingWheelTimer*, kSlots>, kLevels> slots_{};
+};
+
+inline bool TimingWheelTimer::cancel()
+{
+    auto expected = State::Pending;
+    if (!state_.compare_exchange_strong(expected, State::Cancelled)) {
+        return false;
+    }
+    std::shared_ptr<TimingWheelTimer> self;
+    if (auto wheel = wheel_.lock()) {
+        self = wheel->remove(*this);
+    }
+    task_.reset();
+    return true;
+}
+} // namespace asyncly::detail
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/scheduler/IScheduler.h"
+#include "asyncly/scheduler/detail/BaseScheduler.h"
+#include "asyncly/task/Task.h"
+
+namespace asyncly::detail {
+
+/// Timer queue of a ThreadPoolExecutor whose worker threads service the timers themselves,
+/// instead of a SchedulerThread. An idle worker waits for nextExpiry() and calls expire(), which
+/// puts the expired tasks into the task queue of the pool. The wakeup function is called whenever
+/// a timer with an earlier deadline has been scheduled, so that the waiting worker can wait for
+/// the new deadline instead.
+class WorkerScheduler : public IScheduler {
+  public:
+    WorkerScheduler();
+
+    WorkerScheduler(WorkerScheduler const&) = delete;
+    WorkerScheduler& operator=(WorkerScheduler const&) = delete;
+
+    /// must be set before timers are scheduled
+    void setWakeupFunction(std::function<void()> wakeup);
+
+    /// the time the timers have to be serviced next, empty if there are none. Does not lock, as
+    /// it is checked by every worker before every task. May be earlier than the actual deadline
+    /// after timers have been cancelled, until the next expire().
+    std::optional<clock_type::time_point> nextExpiry() const;
+
+    /// posts the expired timers to their executors, returns false without doing anything if
+    /// another thread is at it already
+    bool expire();
+
+    /// like expire(), but waits for another thread that is at it already instead of returning
+    void waitAndExpire();
+
+    // IScheduler
+    clock_type::time_point now() const override;
+
+    std::shared_ptr<Cancelable> execute_at(
+        const IExecutorWPtr& executor, const clock_type::time_point& absTime, Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_after(
+        const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_at_with_slack(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& absTime,
+        const clock_type::duration& slack,
+        Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_periodically(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& firstExpiry,
+        const clock_type::duration& period,
+        CatchUpPolicy policy,
+        RepeatableTask&&) override;
+
+  private:
+    template <typename Schedule> std::shared_ptr<Cancelable> schedule(Schedule&& schedule);
+
+    // must be called with m_expireMutex held
+    void expireLocked();
+
+    // must be called with m_mutex held
+    void updateNextExpiry();
+
+  private:
+    BaseScheduler m_baseScheduler;
+    // protects the timer queue against concurrent scheduling
+    mutable std::mutex m_mutex;
+    // serializes prepareElapse() and elapse()
+    std::mutex m_expireMutex;
+    std::function<void()> m_wakeup;
+    // time since epoch of the earliest deadline in the timer queue, kNoExpiry if it is empty
+    std::atomic<clock_type::rep> m_nextExpiry;
+
+    static constexpr auto kNoExpiry = std::numeric_limits<clock_type::rep>::max();
+};
+
+inline WorkerScheduler::WorkerScheduler()
+    : m_baseScheduler([]() { return clock_type::now(); })
+    , m_nextExpiry(kNoExpiry)
+{
+}
+
+inline void WorkerScheduler::setWakeupFunction(std::function<void()> wakeup)
+{
+    m_wakeup = std::move(wakeup);
+}
+
+inline std::optional<clock_type::time_point> WorkerScheduler::nextExpiry() const
+{
+    const auto nextExpiry = m_nextExpiry.load(std::memory_order_acquire);
+    if (nextExpiry == kNoExpiry) {
+        return {};
+    }
+    return clock_type::time_point{ clock_type::duration{ nextExpiry } };
+}
+
+inline bool WorkerScheduler::expire()
+{
+    std::unique_lock<std::mutex> expireLock(m_expireMutex, std::try_to_lock);
+    if (!expireLock) {
+        return false;
+    }
+    expireLocked();
+    return true;
+}
+
+inline void WorkerScheduler::waitAndExpire()
+{
+    std::lock_guard<std::mutex> expireLock(m_expireMutex);
+    expireLocked();
+}
+
+inline void WorkerScheduler::expireLocked()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_baseScheduler.prepareElapse();
+        updateNextExpiry();
+    }
+    m_baseScheduler.elapse();
+}
+
+inline void WorkerScheduler::updateNextExpiry()
+{
+    const auto nextExpiry = m_baseScheduler.getQueueSize() == 0
+        ? kNoExpiry
+        : m_baseScheduler.getNextExpiredTime(clock_type::time_point::max())
+              .time_since_epoch()
+              .count();
+    m_nextExpiry.store(nextExpiry, std::memory_order_release);
+}
+
+inline asyncly::clock_type::time_point WorkerScheduler::now() const
+{
+    return m_baseScheduler.now();
+}
+
+inline std::shared_ptr<Cancelable> WorkerScheduler::execute_at(
+    const IExecutorWPtr& executor, const clock_type::time_point& absTime, Task&& task)
+{
+    return execute_at_with_slack(executor, absTime, clock_type::duration::zero(), std::move(task));
+}
+
+inline std::shared_ptr<Cancelable> WorkerScheduler::execute_after(
+    const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&& task)
+{
+    return execute_at(executor, now() + relTime, std::move(task));
+}
+
+inline std::shared_ptr<Cancelable> WorkerScheduler::execute_at_with_slack(
+    const IExecutorWPtr& executor,
+    const clock_type::time_point& absTime,
+    const clock_type::duration& slack,
+    Task&& task)
+{
+    return schedule([&]() {
+        return m_baseScheduler.execute_at_with_slack(executor, absTime, slack, std::move(task));
+    });
+}
+
+inline std::shared_ptr<Cancelable> WorkerScheduler::execute_periodically(
+    const IExecutorWPtr& executor,
+    const clock_type::time_point& firstExpiry,
+    const clock_type::duration& period,
+    CatchUpPolicy policy,
+    RepeatableTask&& task)
+{
+    return schedule([&]() {
+        return m_baseScheduler.execute_periodically(
+            executor, firstExpiry, period, policy, std::move(task));
+    });
+}
+
+template <typename Schedule>
+std::shared_ptr<Cancelable> WorkerScheduler::schedule(Schedule&& schedule)
+{
+    bool isEarlier;
+    std::shared_ptr<Cancelable> cancelable;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto isEmpty = m_baseScheduler.getQueueSize() == 0;
+        const auto nextBefore = m_baseScheduler.getNextExpiredTime(clock_type::time_point::max());
+        cancelable = schedule();
+        isEarlier = cancelable
+            && (isEmpty
+                || m_baseScheduler.getNextExpiredTime(clock_type::time_point::max())
+                    < nextBefore);
+        if (isEarlier) {
+            updateNextExpiry();
+        }
+    }
+    // the wakeup function takes the mutex of the executor, so it must not be called with ours
+    if (isEarlier && m_wakeup) {
+        m_wakeup();
+    }
+    return cancelable;
+}
+} // namespace asyncly::detail
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <function2/function2.hpp>
+
+namespace asyncly {
+
+namespace detail {
+class CancellationState {
+  public:
+    using callback_t = fu2::unique_function<void()>;
+    using Callbacks = std::list<callback_t>;
+
+    bool is_cancelled() const
+    {
+        return cancelled_.load(std::memory_order_acquire);
+    }
+
+    bool cancel()
+    {
+        Callbacks callbacks;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            if (cancelled_) {
+                return false;
+            }
+            cancelled_ = true;
+            callbacks.swap(callbacks_);
+        }
+
+        // callbacks are free to unregister or cancel other sources, so no lock must be held
+        for (auto& callback : callbacks) {
+            callback();
+        }
+        return true;
+    }
+
+    /// returns false and does not store the callback if already cancelled
+    bool add(callback_t&& callback, Callbacks::iterator& position)
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        if (cancelled_) {
+            return false;
+        }
+        position = callbacks_.insert(callbacks_.end(), std::move(callback));
+        return true;
+    }
+
+    void remove(Callbacks::iterator position)
+    {
+        callback_t callback;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            if (cancelled_) {
+                // the callback has been or is being called by cancel()
+                return;
+            }
+            callback = std::move(*position);
+            callbacks_.erase(position);
+        }
+    }
+
+  private:
+    std::mutex mutex_;
+    std::atomic<bool> cancelled_{ false };
+    Callbacks callbacks_;
+};
+} // namespace detail
+
+///
+/// CancellationRegistration keeps a callback registered with a
+/// CancellationToken. Destroying or resetting it unregisters the
+/// callback, which is then guaranteed not to be called unless the
+/// token has already been cancelled.
+///
+class CancellationRegistration {
+  public:
+    CancellationRegistration() = default;
+
+    CancellationRegistration(
+        std::weak_ptr<detail::CancellationState> state,
+        detail::CancellationState::Callbacks::iterator position)
+        : state_{ std::move(state) }
+        , position_{ position }
+    {
+    }
+
+    CancellationRegistration(const CancellationRegistration&) = delete;
+    CancellationRegistration& operator=(const CancellationRegistration&) = delete;
+
+    CancellationRegistration(CancellationRegistration&& other) noexcept
+        : state_{ std::move(other.state_) }
+        , position_{ other.position_ }
+    {
+        other.state_.reset();
+    }
+
+    CancellationRegistration& operator=(CancellationRegistration&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            state_ = std::move(other.state_);
+            position_ = other.position_;
+            other.state_.reset();
+        }
+        return *this;
+    }
+
+    ~CancellationRegistration()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        if (auto state = state_.lock()) {
+            state->remove(position_);
+        }
+        state_.reset();
+    }
+
+  private:
+    std::weak_ptr<detail::CancellationState> state_;
+    detail::CancellationState::Callbacks::iterator position_;
+};
+
+///
+/// CancellationToken is the observing side of a CancellationSource and
+/// is handed to asynchronous operations that should stop once their
+/// result is no longer needed. Tokens are cheap to copy. A default
+/// constructed token is never cancelled.
+///
+/// Example usage:
+/// \snippet CancellationTokenTest.cpp CancellationToken FanOut
+///
+class CancellationToken {
+  public:
+    CancellationToken() = default;
+
+    explicit CancellationToken(std::shared_ptr<detail::CancellationState> state)
+        : state_{ std::move(state) }
+    {
+    }
+
+    bool is_cancelled() const
+    {
+        return state_ && state_->is_cancelled();
+    }
+
+    bool can_be_cancelled() const
+    {
+        return state_ != nullptr;
+    }
+
+    ///
+    /// Registers `callback` to be called when the token is
+    /// cancelled. If the token has already been cancelled, `callback`
+    /// is called immediately. Callbacks run on the thread calling
+    /// CancellationSource::cancel and must not block.
+    ///
+    /// \return a registration that unregisters the callback once
+    /// it is destroyed
+    ///
+    template <typename F> [[nodiscard]] CancellationRegistration on_cancel(F&& callback) const
+    {
+        if (!state_) {
+            return {};
+        }
+
+        detail::CancellationState::callback_t wrapped{ std::forward<F>(callback) };
+        detail::CancellationState::Callbacks::iterator position;
+        if (!state_->add(std::move(wrapped), position)) {
+            // add() leaves the callback untouched if the token is already cancelled
+            wrapped();
+            return {};
+        }
+        return { state_, position };
+    }
+
+  private:
+    std::shared_ptr<detail::CancellationState> state_;
+};
+
+///
+/// CancellationSource is the owning side of a cancellation token
+/// tree. Calling cancel() cancels all tokens obtained from it, which
+/// in turn cancels everything they have been attached to, e.g.
+/// futures (see Future::with_cancellation) and timers (see
+/// asyncly::post_after). A source can be linked to a parent token so
+/// that cancelling the parent cancels the source as well.
+///
+class CancellationSource {
+  public:
+    CancellationSource()
+        : state_{ std::make_shared<detail::CancellationState>() }
+    {
+    }
+
+    explicit CancellationSource(const CancellationToken& parent)
+        : CancellationSource()
+    {
+        parentRegistration_ = std::make_shared<CancellationRegistration>(
+            parent.on_cancel([weakState = std::weak_ptr{ state_ }]() {
+                if (auto state = weakState.lock()) {
+                    state->cancel();
+                }
+            }));
+    }
+
+    CancellationToken get_token() const
+    {
+        return CancellationToken{ state_ };
+    }
+
+    /// \return true if this call cancelled the source, false if it was already cancelled
+    bool cancel()
+    {
+        return state_->cancel();
+    }
+
+    bool is_cancelled() const
+    {
+        return state_->is_cancelled();
+    }
+
+  private:
+    std::shared_ptr<detail::CancellationState> state_;
+    std::shared_ptr<CancellationRegistration> parentRegistration_;
+};
+
+} // namespace asyncly
@@ -55,6 +55,12 @@ struct Task {
         return task_ && *task_;
     }
 
+    /// destroys the closure and everything it captured without running it
+    void reset()
+    {
+        task_.reset();
+    }
+
     /// maybe_set_executor should be called by each executor in the
     /// stack the task is posted to. It will eventually make the
     /// original executor available inside the task by calling the
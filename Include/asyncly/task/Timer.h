@@ -0,0 +1,191 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+#include "asyncly/Wrap.h"
+#include "asyncly/executor/IExecutor.h"
+#include "asyncly/task/Cancelable.h"
+#include "asyncly/task/RepeatableTask.h"
+
+namespace asyncly {
+
+/**
+ * Timer is a restartable timer living on an IExecutor, meant for idle and keep-alive timeouts
+ * that are pushed back over and over again. The task runs on the executor whenever the timer is
+ * armed and its deadline passes, and the timer can be armed again afterwards.
+ *
+ * Moving the deadline back with reset() does not touch the scheduler at all, the timer only
+ * remembers the new deadline. When the scheduled expiry happens before it, the timer schedules
+ * itself again for the remembered deadline. So a timer that is reset on every received packet
+ * costs one scheduler entry per timeout period instead of one per packet. Only moving the
+ * deadline forward reschedules right away.
+ *
+ * \snippet TimerTest.cpp Timer Idle Timeout
+ */
+class Timer : public Cancelable, public std::enable_shared_from_this<Timer> {
+  private:
+    // Token to prevent construction from outside create(), but still support std::make_shared
+    struct Token { };
+
+  public:
+    static std::shared_ptr<Timer> create(const IExecutorPtr& executor, RepeatableTask&& task);
+
+    Timer(const IExecutorPtr& executor, RepeatableTask&& task, Token token);
+    ~Timer() override;
+
+    Timer(Timer const&) = delete;
+    Timer& operator=(Timer const&) = delete;
+
+    /// arms the timer or moves its deadline if it is armed already
+    void reset(const clock_type::time_point& deadline);
+    void reset(const clock_type::duration& timeout);
+
+    /// disarms the timer, returns false if it was not armed
+    bool cancel() override;
+
+    bool is_armed() const;
+
+  private:
+    void schedule_(const IExecutorPtr& executor, clock_type::time_point expiry);
+    void onTimer_(std::uint64_t generation);
+
+  private:
+    mutable std::mutex mutex_;
+    const std::weak_ptr<IExecutor> executor_;
+    const std::shared_ptr<RepeatableTask> task_;
+
+    // the deadline the timer has been armed for, empty while disarmed
+    std::optional<clock_type::time_point> deadline_;
+    // the expiry the executor has currently been asked for, never later than deadline_
+    clock_type::time_point scheduledExpiry_;
+    std::shared_ptr<Cancelable> scheduled_;
+    // identifies the current expiry, an earlier one may still run if cancelling it was too late
+    std::uint64_t generation_ = 0;
+};
+
+inline std::shared_ptr<Timer> Timer::create(const IExecutorPtr& executor, RepeatableTask&& task)
+{
+    if (!task) {
+        throw std::runtime_error("Timer: invalid closure");
+    }
+    return std::make_shared<Timer>(executor, std::move(task), Token{});
+}
+
+inline Timer::Timer(const IExecutorPtr& executor, RepeatableTask&& task, Token)
+    : executor_(executor)
+    , task_(std::make_shared<RepeatableTask>(std::move(task)))
+{
+}
+
+inline Timer::~Timer()
+{
+    if (scheduled_) {
+        scheduled_->cancel();
+    }
+}
+
+inline void Timer::reset(const clock_type::time_point& deadline)
+{
+    auto executor = executor_.lock();
+    if (!executor) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    deadline_ = deadline;
+    if (scheduled_ && scheduledExpiry_ <= deadline) {
+        // onTimer_() takes care of the later deadline
+        return;
+    }
+    if (scheduled_) {
+        scheduled_->cancel();
+    }
+    schedule_(executor, deadline);
+}
+
+inline void Timer::reset(const clock_type::duration& timeout)
+{
+    if (auto executor = executor_.lock()) {
+        reset(executor->now() + timeout);
+    }
+}
+
+inline bool Timer::cancel()
+{
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    if (!deadline_) {
+        return false;
+    }
+    deadline_.reset();
+    if (scheduled_) {
+        scheduled_->cancel();
+        scheduled_.reset();
+    }
+    return true;
+}
+
+inline bool Timer::is_armed() const
+{
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    return deadline_.has_value();
+}
+
+inline void Timer::schedule_(const IExecutorPtr& executor, clock_type::time_point expiry)
+{
+    scheduledExpiry_ = expiry;
+    scheduled_ = executor->post_at(
+        expiry,
+        asyncly::wrap_weak_this_ignore(
+            this, [this, generation = ++generation_](auto) { onTimer_(generation); }));
+}
+
+inline void Timer::onTimer_(std::uint64_t generation)
+{
+    auto executor = executor_.lock();
+    if (!executor) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        if (generation != generation_) {
+            return;
+        }
+        scheduled_.reset();
+        if (!deadline_) {
+            return;
+        }
+        if (*deadline_ > executor->now()) {
+            // the deadline has been moved back since this expiry was scheduled
+            schedule_(executor, *deadline_);
+            return;
+        }
+        deadline_.reset();
+    }
+
+    // the task may re-arm the timer, so it must not run while holding the mutex
+    (*task_)();
+}
+} // namespace asyncly
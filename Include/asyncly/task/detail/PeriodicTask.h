@@ -27,6 +27,9 @@ namespace asyncly::detail {
 /**
  * Implementation of a periodic task, using the IExecutor framework. Until cancelled, it will
  * re-post itself. Construction is via create(), as we need to allocate and then schedule.
+ *
+ * create() uses a native periodic timer instead if the scheduler of the executor supports them,
+ * which is re-inserted into the timer queue in place and does not allocate per tick.
  */
 class PeriodicTask : public Cancelable, public std::enable_shared_from_this<PeriodicTask> {
   private:
@@ -36,8 +39,19 @@ class PeriodicTask : public Cancelable, public std::enable_shared_from_this<Peri
   public:
     // Due to the constructor wanting to schedule, and scheduling relying upon weak_from_this(), we
     // need a creator
-    static std::shared_ptr<Cancelable>
-    create(const clock_type::duration& period, RepeatableTask&& task, const IExecutorPtr& executor);
+    static std::shared_ptr<Cancelable> create(
+        const clock_type::duration& period,
+        RepeatableTask&& task,
+        const IExecutorPtr& executor,
+        CatchUpPolicy policy = CatchUpPolicy::Burst);
+
+    // Always re-posts the task with post_at(), for executor wrappers that have to see every tick
+    // as a timed task, a native periodic timer hands its ticks to post() instead
+    static std::shared_ptr<Cancelable> createReposting(
+        const clock_type::duration& period,
+        RepeatableTask&& task,
+        const IExecutorPtr& executor,
+        CatchUpPolicy policy = CatchUpPolicy::Burst);
 
   public:
     bool cancel() override;
@@ -47,6 +61,7 @@ class PeriodicTask : public Cancelable, public std::enable_shared_from_this<Peri
         const clock_type::duration& period,
         RepeatableTask&& task,
         const IExecutorPtr& executor,
+        CatchUpPolicy policy,
         Token token);
 
   private:
@@ -58,6 +73,7 @@ class PeriodicTask : public Cancelable, public std::enable_shared_from_this<Peri
     const clock_type::duration period_;
     std::shared_ptr<RepeatableTask> task_;
     const std::weak_ptr<IExecutor> executor_;
+    const CatchUpPolicy policy_;
 
     bool cancelled_;
     std::shared_ptr<Cancelable> currentDelayedTask_;
@@ -24,8 +24,14 @@ AsioExecutorController::AsioExecutorController(
 {
     auto scheduler = optionalScheduler;
     if (!scheduler) {
+        std::shared_ptr<IRunnableScheduler> runnableScheduler;
+        if (threadConfig.schedulerFactory) {
+            runnableScheduler = threadConfig.schedulerFactory();
+        } else {
+            runnableScheduler = std::make_shared<DefaultScheduler>();
+        }
         m_schedulerThread = std::make_shared<SchedulerThread>(
-            threadConfig.schedulerInitFunction, std::make_shared<DefaultScheduler>());
+            threadConfig.schedulerInitFunction, std::move(runnableScheduler));
         scheduler = m_schedulerThread->get_scheduler();
     }
     m_executor = std::make_unique<AsioExecutor>(scheduler);
@@ -141,8 +141,10 @@ template <typename Base>
 std::shared_ptr<AutoCancelable>
 MetricsWrapper<Base>::post_periodically(const clock_type::duration& period, RepeatableTask&& task)
 {
+    // native periodic timers would post their ticks as immediate tasks, re-posting them keeps
+    // every tick in the timed metrics
     return std::make_shared<AutoCancelable>(
-        detail::PeriodicTask::create(period, std::move(task), this->shared_from_this()));
+        detail::PeriodicTask::createReposting(period, std::move(task), this->shared_from_this()));
 }
 
 template <typename Base>
@@ -27,20 +27,32 @@ ThreadPoolExecutorController::ThreadPoolExecutorController(
     const ThreadPoolConfig& threadPoolConfig, const ISchedulerPtr& optionalScheduler)
 {
     auto scheduler = optionalScheduler;
-    if (!scheduler) {
+    std::shared_ptr<detail::WorkerScheduler> workerScheduler;
+    if (!scheduler && threadPoolConfig.workerTimers) {
+        workerScheduler = std::make_shared<detail::WorkerScheduler>();
+    } else if (!scheduler) {
+        std::shared_ptr<IRunnableScheduler> runnableScheduler;
+        if (threadPoolConfig.schedulerFactory) {
+            runnableScheduler = threadPoolConfig.schedulerFactory();
+        } else {
+            runnableScheduler = std::make_shared<DefaultScheduler>();
+        }
         m_schedulerThread = std::make_shared<SchedulerThread>(
-            threadPoolConfig.schedulerInitFunction, std::make_shared<DefaultScheduler>());
+            threadPoolConfig.schedulerInitFunction, std::move(runnableScheduler));
         scheduler = m_schedulerThread->get_scheduler();
     }
 
     const bool isSerializingExecutor = (threadPoolConfig.executorInitFunctions.size() == 1);
     if (isSerializingExecutor) {
-        const auto executor = ThreadPoolExecutor<IStrand>::create(threadPoolConfig.name, scheduler);
+        const auto executor = workerScheduler
+            ? ThreadPoolExecutor<IStrand>::create(threadPoolConfig.name, workerScheduler)
+            : ThreadPoolExecutor<IStrand>::create(threadPoolConfig.name, scheduler);
         m_executor = executor;
         m_threadPoolExecutor = executor;
     } else {
-        const auto executor
-            = ThreadPoolExecutor<IExecutor>::create(threadPoolConfig.name, scheduler);
+        const auto executor = workerScheduler
+            ? ThreadPoolExecutor<IExecutor>::create(threadPoolConfig.name, workerScheduler)
+            : ThreadPoolExecutor<IExecutor>::create(threadPoolConfig.name, scheduler);
         m_executor = executor;
         m_threadPoolExecutor = executor;
     }
@@ -18,14 +18,35 @@
 
 #include "asyncly/task/detail/PeriodicTask.h"
 #include "asyncly/Wrap.h"
+#include "asyncly/scheduler/IScheduler.h"
 
 namespace asyncly::detail {
 
 std::shared_ptr<Cancelable> PeriodicTask::create(
-    const clock_type::duration& period, RepeatableTask&& task, const IExecutorPtr& executor)
+    const clock_type::duration& period,
+    RepeatableTask&& task,
+    const IExecutorPtr& executor,
+    CatchUpPolicy policy)
 {
-    auto periodicTask
-        = std::make_shared<PeriodicTask>(period, std::move(task), executor, PeriodicTask::Token{});
+    if (const auto scheduler = executor->get_scheduler()) {
+        // leaves the task alone if the scheduler has no native periodic timers
+        if (auto timer = scheduler->execute_periodically(
+                executor, executor->now() + period, period, policy, std::move(task))) {
+            return timer;
+        }
+    }
+
+    return createReposting(period, std::move(task), executor, policy);
+}
+
+std::shared_ptr<Cancelable> PeriodicTask::createReposting(
+    const clock_type::duration& period,
+    RepeatableTask&& task,
+    const IExecutorPtr& executor,
+    CatchUpPolicy policy)
+{
+    auto periodicTask = std::make_shared<PeriodicTask>(
+        period, std::move(task), executor, policy, PeriodicTask::Token{});
     periodicTask->scheduleTask_();
     return periodicTask;
 }
@@ -34,10 +55,12 @@ PeriodicTask::PeriodicTask(
     const clock_type::duration& period,
     RepeatableTask&& task,
     const IExecutorPtr& executor,
+    CatchUpPolicy policy,
     PeriodicTask::Token)
     : period_(period)
     , task_(std::make_shared<RepeatableTask>(std::move(task)))
     , executor_(executor)
+    , policy_(policy)
     , cancelled_(false)
     , expiry_(executor->now())
 {
@@ -64,6 +87,12 @@ void PeriodicTask::scheduleTask_()
 {
     expiry_ += period_;
     if (auto executor = executor_.lock()) {
+        const auto now = executor->now();
+        if (policy_ != CatchUpPolicy::Burst && period_ > clock_type::duration::zero()
+            && expiry_ <= now) {
+            // continue with the first tick after now instead of catching up
+            expiry_ += period_ * ((now - expiry_) / period_ + 1);
+        }
         currentDelayedTask_ = executor->post_at(
             expiry_, asyncly::wrap_weak_this_ignore(this, [this](auto) { onTimer_(); }));
     }
@@ -79,7 +108,13 @@ void PeriodicTask::onTimer_()
         if (cancelled_) {
             return;
         }
+        const auto executor = executor_.lock();
+        const auto missed = policy_ == CatchUpPolicy::Skip && executor
+            && period_ > clock_type::duration::zero() && executor->now() >= expiry_ + period_;
         scheduleTask_();
+        if (missed) {
+            return;
+        }
         task = task_;
     }
 
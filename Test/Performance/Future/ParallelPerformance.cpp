@@ -0,0 +1,120 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <numeric>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <asyncly/executor/ThreadPoolExecutorController.h>
+#include <asyncly/future/BlockingWait.h>
+#include <asyncly/future/Parallel.h>
+
+namespace asyncly {
+namespace {
+const std::size_t kElements = 1 << 20;
+
+std::vector<double> makeInput()
+{
+    std::vector<double> input(kElements);
+    std::iota(input.begin(), input.end(), 0.0);
+    return input;
+}
+
+double work(double value)
+{
+    return std::sqrt(std::abs(value) + 1.0) * std::sin(value);
+}
+} // namespace
+} // namespace asyncly
+
+using namespace asyncly;
+
+// baseline: what hand-rolled code posting one task per element costs
+static void postPerElement(benchmark::State& state)
+{
+    auto executorController
+        = ThreadPoolExecutorController::create(static_cast<size_t>(state.range(0)));
+    auto executor = executorController->get_executor();
+    auto input = makeInput();
+    std::vector<double> output(input.size());
+
+    for (const auto _ : state) {
+        std::atomic<std::size_t> remaining{ input.size() };
+        std::promise<void> done;
+        for (std::size_t i = 0; i < input.size(); i++) {
+            executor->post([i, &input, &output, &remaining, &done]() {
+                output[i] = work(input[i]);
+                if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    done.set_value();
+                }
+            });
+        }
+        done.get_future().get();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kElements));
+}
+
+static void parallelFor(benchmark::State& state)
+{
+    auto executorController
+        = ThreadPoolExecutorController::create(static_cast<size_t>(state.range(0)));
+    auto executor = executorController->get_executor();
+    auto input = makeInput();
+
+    for (const auto _ : state) {
+        blocking_wait(parallel_for(executor, input, [](double& value) { value = work(value); }));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kElements));
+}
+
+static void parallelTransform(benchmark::State& state)
+{
+    auto executorController
+        = ThreadPoolExecutorController::create(static_cast<size_t>(state.range(0)));
+    auto executor = executorController->get_executor();
+    auto input = makeInput();
+
+    for (const auto _ : state) {
+        auto output = blocking_wait(parallel_transform(executor, input, work));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kElements));
+}
+
+static void parallelReduce(benchmark::State& state)
+{
+    auto executorController
+        = ThreadPoolExecutorController::create(static_cast<size_t>(state.range(0)));
+    auto executor = executorController->get_executor();
+    auto input = makeInput();
+
+    for (const auto _ : state) {
+        auto sum = blocking_wait(parallel_reduce(executor, input, 0.0, std::plus<>{}));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kElements));
+}
+
+BENCHMARK(postPerElement)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK(parallelFor)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK(parallelTransform)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK(parallelReduce)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
@@ -73,16 +73,27 @@ class BaseSchedulerTest : public Test {
     {
     }
 
-    void addTask(size_t index, clock_type::time_point timePoint)
+    std::shared_ptr<Cancelable> addTask(size_t index, clock_type::time_point timePoint)
     {
         _expectedTasks.insert(ExecutedTaskInfo{ index, timePoint });
-        _scheduler->execute_at(_executor, timePoint, [this, index]() {
+        return _scheduler->execute_at(_executor, timePoint, [this, index]() {
             _executedTasks.push_back(ExecutedTaskInfo{ index, now });
         });
     }
-    void addTask(size_t index, clock_type::duration duration)
+    std::shared_ptr<Cancelable> addTask(size_t index, clock_type::duration duration)
     {
-        addTask(index, now + duration);
+        return addTask(index, now + duration);
+    }
+
+    void cancelTask(size_t index, const std::shared_ptr<Cancelable>& cancelable)
+    {
+        EXPECT_TRUE(cancelable->cancel());
+        for (auto it = _expectedTasks.begin(); it != _expectedTasks.end(); ++it) {
+            if (it->index == index) {
+                _expectedTasks.erase(it);
+                break;
+            }
+        }
     }
 
     void advance(clock_type::duration duration)
@@ -236,6 +247,54 @@ TEST_F(BaseSchedulerTest, shouldGetNowWhenNoLastExpiredTime)
     EXPECT_EQ(now, _scheduler->getLastExpiredTime());
 }
 
+TEST_F(BaseSchedulerTest, shouldRemoveCancelledTasksFromQueue)
+{
+    auto first = addTask(1, std::chrono::milliseconds(5));
+    auto second = addTask(2, std::chrono::milliseconds(10));
+    addTask(3, std::chrono::milliseconds(20));
+    EXPECT_EQ(3u, _scheduler->getQueueSize());
+
+    cancelTask(2, second);
+    EXPECT_EQ(2u, _scheduler->getQueueSize());
+    EXPECT_FALSE(second->cancel());
+    EXPECT_EQ(2u, _scheduler->getQueueSize());
+
+    cancelTask(1, first);
+    EXPECT_EQ(1u, _scheduler->getQueueSize());
+    EXPECT_EQ(
+        now + std::chrono::milliseconds(20),
+        _scheduler->getNextExpiredTime(now + std::chrono::hours(1)));
+
+    advanceAndVerify(clock_type::duration::max());
+    EXPECT_EQ(0u, _scheduler->getQueueSize());
+}
+
+TEST_F(BaseSchedulerTest, shouldKeepOrderWhenCancellingManyTasks)
+{
+    std::vector<std::shared_ptr<Cancelable>> cancelables;
+    for (size_t i = 0; i < 100; i++) {
+        cancelables.push_back(addTask(i, std::chrono::milliseconds((i * 37) % 101)));
+    }
+    for (size_t i = 0; i < 100; i += 3) {
+        cancelTask(i, cancelables[i]);
+    }
+    EXPECT_EQ(66u, _scheduler->getQueueSize());
+
+    advanceAndVerify(clock_type::duration::max());
+    EXPECT_EQ(0u, _scheduler->getQueueSize());
+}
+
+TEST_F(BaseSchedulerTest, shouldNotRemoveElapsedTaskOnCancel)
+{
+    auto cancelable = addTask(1, std::chrono::milliseconds(5));
+    addTask(2, std::chrono::milliseconds(10));
+    now += std::chrono::milliseconds(5);
+    _scheduler->prepareElapse();
+
+    EXPECT_TRUE(cancelable->cancel());
+    EXPECT_EQ(1u, _scheduler->getQueueSize());
+}
+
 TEST_F(BaseSchedulerTest, shouldNotThrowWhenExecutorIsStopped)
 {
     auto executorController = asyncly::ThreadPoolExecutorController::create(1);
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "gmock/gmock.h"
+
+#include "asyncly/executor/ThreadPoolExecutorController.h"
+#include "asyncly/scheduler/DefaultScheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+namespace asyncly {
+
+using namespace testing;
+
+class DefaultSchedulerTest : public Test {
+  public:
+    void SetUp() override
+    {
+        ThreadPoolConfig config;
+        config.executorInitFunctions.emplace_back([]() {});
+        controller_ = ThreadPoolExecutorController::create(config);
+        executor_ = controller_->get_executor();
+    }
+
+    void startScheduler(clock_type::duration timerSlack = clock_type::duration::zero())
+    {
+        scheduler_ = std::make_shared<DefaultScheduler>(timerSlack);
+        thread_ = std::thread([this]() { scheduler_->run(); });
+    }
+
+    void TearDown() override
+    {
+        if (scheduler_) {
+            scheduler_->stop();
+            thread_.join();
+        }
+        controller_->finish();
+    }
+
+  protected:
+    std::shared_ptr<IExecutorController> controller_;
+    IExecutorPtr executor_;
+    std::shared_ptr<DefaultScheduler> scheduler_;
+    std::thread thread_;
+};
+
+TEST_F(DefaultSchedulerTest, shouldStopWhileIdle)
+{
+    startScheduler();
+    scheduler_->stop();
+    thread_.join();
+    scheduler_.reset();
+}
+
+TEST_F(DefaultSchedulerTest, shouldWakeUpForEarlierTimer)
+{
+    startScheduler();
+    scheduler_->execute_after(executor_, std::chrono::hours(1), []() {});
+
+    std::promise<void> executed;
+    const auto start = scheduler_->now();
+    scheduler_->execute_after(
+        executor_, std::chrono::milliseconds(10), [&executed]() { executed.set_value(); });
+
+    executed.get_future().get();
+    EXPECT_GE(scheduler_->now() - start, std::chrono::milliseconds(10));
+}
+
+TEST_F(DefaultSchedulerTest, shouldNotExecuteTimersEarlyWithSlack)
+{
+    startScheduler(std::chrono::milliseconds(20));
+
+    std::promise<clock_type::time_point> first;
+    std::promise<clock_type::time_point> second;
+    const auto start = scheduler_->now();
+    scheduler_->execute_at(executor_, start + std::chrono::milliseconds(10), [&]() {
+        first.set_value(scheduler_->now());
+    });
+    scheduler_->execute_at(executor_, start + std::chrono::milliseconds(15), [&]() {
+        second.set_value(scheduler_->now());
+    });
+
+    EXPECT_GE(first.get_future().get() - start, std::chrono::milliseconds(10));
+    EXPECT_GE(second.get_future().get() - start, std::chrono::milliseconds(15));
+}
+
+TEST_F(DefaultSchedulerTest, shouldWaitForFarFutureTimerWithSlack)
+{
+    startScheduler(std::chrono::milliseconds(20));
+
+    std::atomic<bool> farExecuted{ false };
+    scheduler_->execute_at(
+        executor_, clock_type::time_point::max(), [&farExecuted]() { farExecuted = true; });
+
+    std::promise<void> executed;
+    const auto start = scheduler_->now();
+    scheduler_->execute_after(
+        executor_, std::chrono::milliseconds(10), [&executed]() { executed.set_value(); });
+
+    executed.get_future().get();
+    EXPECT_GE(scheduler_->now() - start, std::chrono::milliseconds(10));
+    EXPECT_FALSE(farExecuted);
+}
+
+} // namespace asyncly
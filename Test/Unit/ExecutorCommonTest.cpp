@@ -36,7 +36,9 @@ using ExecutorFactoryTypes = ::testing::Types<
     asyncly::test::DefaultExecutorFactory<>,
     asyncly::test::DefaultExecutorFactory<5>,
     asyncly::test::StrandImplTestFactory<>,
-    asyncly::test::ExternalEventExecutorFactory<>>;
+    asyncly::test::ExternalEventExecutorFactory<>,
+    asyncly::test::WorkerTimersExecutorFactory<>,
+    asyncly::test::WorkerTimersExecutorFactory<5>>;
 
 INSTANTIATE_TYPED_TEST_SUITE_P(ThreadPoolExecutor, ExecutorCommonTest, ExecutorFactoryTypes);
 
@@ -44,9 +46,22 @@ using ScheduledExecutorFactoryTypes = ::testing::Types<
     AsioExecutorFactory<>,
     DefaultExecutorFactory<>,
     StrandImplTestFactory<>,
+    WorkerTimersExecutorFactory<>,
+    WorkerTimersExecutorFactory<5>,
     AsioExecutorFactory<SchedulerProviderDefault>,
     DefaultExecutorFactory<1, SchedulerProviderDefault>,
-    StrandImplTestFactory<SchedulerProviderDefault>
+    StrandImplTestFactory<SchedulerProviderDefault>,
+    AsioExecutorFactory<SchedulerProviderTimingWheel>,
+    DefaultExecutorFactory<1, SchedulerProviderTimingWheel>,
+    StrandImplTestFactory<SchedulerProviderTimingWheel>,
+#if defined(__linux__)
+    AsioExecutorFactory<SchedulerProviderTimerFd>,
+    DefaultExecutorFactory<1, SchedulerProviderTimerFd>,
+    StrandImplTestFactory<SchedulerProviderTimerFd>,
+#endif
+    AsioExecutorFactory<SchedulerProviderSharded>,
+    DefaultExecutorFactory<1, SchedulerProviderSharded>,
+    StrandImplTestFactory<SchedulerProviderSharded>
     /*, disabled SchedulerProviderAsio due to flaky test
     (https://jira.ops.expertcity.com/browse/ACINI-1142)
     Executor/ScheduledExecutorCommonTest/9.shouldExecuteBeforeNewestExpires,
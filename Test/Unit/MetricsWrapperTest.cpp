@@ -272,6 +272,22 @@ TEST_F(MetricsWrapperTest, shouldNotDecrementTwiceOnDoubleCancel)
     EXPECT_DOUBLE_EQ(result.metric.gauge.value, static_cast<double>(0));
 }
 
+TEST_F(MetricsWrapperTest, shouldCountPeriodicTasksAsTimed)
+{
+    const auto periodicTask = metricsExecutor_->post_periodically(std::chrono::seconds(1), []() {});
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(3500));
+
+    const auto families = registry_->Collect();
+    const auto result = detail::grabMetric(
+        families,
+        prometheus::MetricType::Counter,
+        "processed_tasks_total",
+        targetCounterValue_[PostCallType::kPostAt]);
+    EXPECT_TRUE(result.success) << result.errorMessage;
+
+    EXPECT_DOUBLE_EQ(result.metric.counter.value, 3.0);
+}
+
 TEST_P(MetricsWrapperTest, shouldMeasureTaskRuntime)
 {
     const auto expectedSummarizedTaskRuntime = 500;
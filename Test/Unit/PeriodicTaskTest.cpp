@@ -20,11 +20,14 @@
 #include <future>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "gmock/gmock.h"
 
+#include "asyncly/executor/PeriodicPost.h"
 #include "asyncly/executor/ThreadPoolExecutorController.h"
 #include "asyncly/test/FakeClockScheduler.h"
+#include "asyncly/test/FakeExecutor.h"
 
 using namespace std::chrono_literals;
 
@@ -109,4 +112,124 @@ TEST(
     taskDestroyed.get_future().get();
 }
 
+class PeriodicTaskCatchUpTest : public testing::Test {
+  public:
+    PeriodicTaskCatchUpTest()
+        : executor_(test::FakeExecutor::create())
+        , scheduler_(std::dynamic_pointer_cast<test::FakeClockScheduler>(
+              executor_->get_scheduler()))
+        , start_(executor_->now())
+    {
+    }
+
+    std::shared_ptr<AutoCancelable> postPeriodically(CatchUpPolicy policy)
+    {
+        return post_periodically(executor_, period, policy, [this]() { runs_++; });
+    }
+
+    // lets the scheduler wake up late, at `start_ + delay`
+    void wakeUpAt(clock_type::duration delay)
+    {
+        scheduler_->setClock(start_ + delay);
+        scheduler_->advanceClockToNextEvent(start_ + delay);
+    }
+
+  protected:
+    std::shared_ptr<test::FakeExecutor> executor_;
+    std::shared_ptr<test::FakeClockScheduler> scheduler_;
+    const clock_type::time_point start_;
+    int runs_ = 0;
+};
+
+TEST_F(PeriodicTaskCatchUpTest, shouldRunOnFixedScheduleWithoutDrift)
+{
+    std::vector<clock_type::duration> runs;
+    auto periodicTask = executor_->post_periodically(
+        period, [&]() { runs.push_back(executor_->now() - start_); });
+
+    for (auto i = 0; i < 10; i++) {
+        executor_->advanceClock(7ms);
+    }
+
+    EXPECT_THAT(runs, testing::ElementsAre(10ms, 20ms, 30ms, 40ms, 50ms, 60ms, 70ms));
+    EXPECT_EQ(1u, executor_->queuedSchedulerTasks());
+}
+
+TEST_F(PeriodicTaskCatchUpTest, shouldRemoveTimerWhenCancelled)
+{
+    auto periodicTask = postPeriodically(CatchUpPolicy::Burst);
+    executor_->advanceClock(period);
+    periodicTask.reset();
+    EXPECT_EQ(0u, executor_->queuedSchedulerTasks());
+
+    executor_->advanceClock(3 * period);
+    EXPECT_EQ(1, runs_);
+}
+
+TEST_F(PeriodicTaskCatchUpTest, shouldReleaseTaskWhenCancelled)
+{
+    auto owner = std::make_shared<int>(0);
+    const std::weak_ptr<int> weakOwner = owner;
+    auto timer = scheduler_->execute_periodically(
+        executor_, start_ + period, period, CatchUpPolicy::Burst, [owner = std::move(owner)]() {
+            (*owner)++;
+        });
+    executor_->advanceClock(period);
+    EXPECT_EQ(1, *weakOwner.lock());
+
+    EXPECT_TRUE(timer->cancel());
+    EXPECT_TRUE(weakOwner.expired());
+}
+
+TEST_F(PeriodicTaskCatchUpTest, shouldBurstMissedTicks)
+{
+    auto periodicTask = postPeriodically(CatchUpPolicy::Burst);
+    wakeUpAt(35ms);
+    executor_->runTasks();
+    EXPECT_EQ(3, runs_);
+
+    executor_->advanceClock(5ms);
+    EXPECT_EQ(4, runs_);
+}
+
+TEST_F(PeriodicTaskCatchUpTest, shouldSkipMissedTicks)
+{
+    auto periodicTask = postPeriodically(CatchUpPolicy::Skip);
+    wakeUpAt(35ms);
+    executor_->runTasks();
+    EXPECT_EQ(0, runs_);
+
+    executor_->advanceClock(5ms);
+    EXPECT_EQ(1, runs_);
+}
+
+TEST_F(PeriodicTaskCatchUpTest, shouldCoalesceMissedTicks)
+{
+    auto periodicTask = postPeriodically(CatchUpPolicy::Coalesce);
+    wakeUpAt(35ms);
+    executor_->runTasks();
+    EXPECT_EQ(1, runs_);
+
+    executor_->advanceClock(5ms);
+    EXPECT_EQ(2, runs_);
+}
+
+TEST_F(PeriodicTaskCatchUpTest, shouldNotQueueMoreThanOneRunOnBusyExecutor)
+{
+    //! [Post Periodically With Policy]
+    auto burst = postPeriodically(CatchUpPolicy::Burst);
+    auto coalesce = post_periodically(
+        executor_, period, CatchUpPolicy::Coalesce, [this]() { runs_ += 100; });
+    //! [Post Periodically With Policy]
+
+    // the executor does not get to run the ticks in the meantime
+    for (auto i = 1; i <= 3; i++) {
+        scheduler_->advanceClockToNextEvent(start_ + i * period);
+    }
+    EXPECT_EQ(2u, executor_->queuedTasks());
+
+    executor_->runTasks();
+    EXPECT_EQ(103, runs_);
+}
+
 } // namespace asyncly
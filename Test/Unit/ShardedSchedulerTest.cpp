@@ -0,0 +1,154 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "gmock/gmock.h"
+
+#include "asyncly/executor/ThreadPoolExecutorController.h"
+#include "asyncly/scheduler/SchedulerThread.h"
+#include "asyncly/scheduler/ShardedScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace asyncly {
+
+using namespace testing;
+
+TEST(ShardedSchedulerTest, shouldRejectZeroShards)
+{
+    EXPECT_THROW(ShardedScheduler{ 0 }, std::invalid_argument);
+}
+
+TEST(ShardedSchedulerTest, shouldStopBeforeRun)
+{
+    ShardedScheduler scheduler{ 4 };
+    scheduler.stop();
+    scheduler.run();
+}
+
+TEST(ShardedSchedulerTest, shouldRunInitFunctionOnEveryShardThread)
+{
+    constexpr auto kShards = 4;
+    std::atomic<int> initialized{ 0 };
+    std::promise<void> done;
+    {
+        SchedulerThread schedulerThread{
+            [&]() {
+                if (++initialized == kShards) {
+                    done.set_value();
+                }
+            },
+            std::make_shared<ShardedScheduler>(kShards)
+        };
+        done.get_future().get();
+    }
+    EXPECT_EQ(kShards, initialized.load());
+}
+
+TEST(ShardedSchedulerTest, shouldRunTimersScheduledFromManyThreads)
+{
+    const auto scheduler = std::make_shared<ShardedScheduler>(4);
+    SchedulerThread schedulerThread{ ThreadInitFunction{}, scheduler };
+    auto controller = ThreadPoolExecutorController::create(1);
+    auto executor = controller->get_executor();
+
+    constexpr auto kThreads = 8;
+    constexpr auto kTimersPerThread = 50;
+    std::atomic<int> executed{ 0 };
+    std::promise<void> done;
+
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < kThreads; i++) {
+        threads.emplace_back([&]() {
+            for (auto j = 0; j < kTimersPerThread; j++) {
+                scheduler->execute_after(executor, std::chrono::milliseconds(j % 5), [&]() {
+                    if (++executed == kThreads * kTimersPerThread) {
+                        done.set_value();
+                    }
+                });
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    done.get_future().get();
+    EXPECT_EQ(kThreads * kTimersPerThread, executed.load());
+}
+
+TEST(ShardedSchedulerTest, shouldKeepOrderOfTimersOfSameExecutorScheduledFromManyThreads)
+{
+    const auto scheduler = std::make_shared<ShardedScheduler>(4);
+    SchedulerThread schedulerThread{ ThreadInitFunction{}, scheduler };
+    auto controller = ThreadPoolExecutorController::create(1);
+    auto executor = controller->get_executor();
+
+    constexpr auto kTimers = 20;
+    std::vector<int> executed;
+    std::promise<void> done;
+    const auto start = scheduler->now() + std::chrono::milliseconds(50);
+
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < kTimers; i++) {
+        threads.emplace_back([&, i]() {
+            scheduler->execute_at(executor, start + std::chrono::microseconds(100) * i, [&, i]() {
+                executed.push_back(i);
+                if (executed.size() == kTimers) {
+                    done.set_value();
+                }
+            });
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    done.get_future().get();
+    EXPECT_TRUE(std::is_sorted(executed.begin(), executed.end()));
+}
+
+TEST(ShardedSchedulerTest, shouldRunTimersOfThreadPool)
+{
+    //! [ShardedScheduler Factory]
+    ThreadPoolConfig config;
+    for (auto i = 0; i < 4; i++) {
+        config.executorInitFunctions.emplace_back([]() {});
+    }
+    config.schedulerInitFunction = []() { /* runs on every shard thread */ };
+    config.schedulerFactory = []() { return std::make_shared<ShardedScheduler>(2); };
+    auto controller = ThreadPoolExecutorController::create(config);
+    //! [ShardedScheduler Factory]
+
+    std::promise<void> executed;
+    auto executor = controller->get_executor();
+    const auto start = executor->now();
+    executor->post([executor, &executed]() {
+        executor->post_after(
+            std::chrono::milliseconds(10), [&executed]() { executed.set_value(); });
+    });
+
+    executed.get_future().get();
+    EXPECT_GE(executor->now() - start, std::chrono::milliseconds(10));
+}
+
+} // namespace asyncly
@@ -21,7 +21,9 @@
 #include <array>
 #include <chrono>
 #include <future>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "asyncly/executor/InlineExecutor.h"
 #include "asyncly/executor/ThreadPoolExecutorController.h"
@@ -144,4 +146,61 @@ TEST_F(ThreadPoolExecutorTest, shouldNotThrowOnGetCurrentExecutorInNestedTasks)
     });
     promiseFinished.get_future().wait();
 }
+
+TEST_F(ThreadPoolExecutorTest, shouldRunTimersOnWorkerThreads)
+{
+    std::mutex mutex;
+    std::vector<std::thread::id> workerThreadIds;
+    const auto recordWorkerThreadId = [&mutex, &workerThreadIds]() {
+        std::lock_guard<std::mutex> lock{ mutex };
+        workerThreadIds.push_back(std::this_thread::get_id());
+    };
+
+    ThreadPoolConfig config;
+    config.executorInitFunctions = { recordWorkerThreadId, recordWorkerThreadId };
+    config.workerTimers = true;
+    auto executorController = ThreadPoolExecutorController::create(config);
+    auto executor = executorController->get_executor();
+
+    std::promise<std::thread::id> timerThread;
+    const auto start = executor->now();
+    executor->post_after(std::chrono::milliseconds(10), [&timerThread]() {
+        timerThread.set_value(std::this_thread::get_id());
+    });
+
+    // an inline executor runs the timer on the thread that expired it, which would be the
+    // scheduler thread if there was one
+    std::promise<std::thread::id> expiringThread;
+    const auto inlineExecutor = InlineExecutor::create();
+    executor->get_scheduler()->execute_after(
+        inlineExecutor, std::chrono::milliseconds(10), [&expiringThread]() {
+            expiringThread.set_value(std::this_thread::get_id());
+        });
+
+    const auto timerThreadId = timerThread.get_future().get();
+    const auto expiringThreadId = expiringThread.get_future().get();
+    EXPECT_GE(executor->now() - start, std::chrono::milliseconds(10));
+
+    std::lock_guard<std::mutex> lock{ mutex };
+    EXPECT_THAT(workerThreadIds, Contains(timerThreadId));
+    EXPECT_THAT(workerThreadIds, Contains(expiringThreadId));
+}
+
+TEST_F(ThreadPoolExecutorTest, shouldWakeUpWorkersForEarlierTimer)
+{
+    ThreadPoolConfig config;
+    config.executorInitFunctions = { []() {} };
+    config.workerTimers = true;
+    auto executorController = ThreadPoolExecutorController::create(config);
+    auto executor = executorController->get_executor();
+
+    std::promise<void> executed;
+    auto later = executor->post_after(std::chrono::hours(1), []() {});
+    // give the worker time to start waiting for the later timer
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    executor->post_after(std::chrono::milliseconds(10), [&executed]() { executed.set_value(); });
+
+    EXPECT_EQ(std::future_status::ready, executed.get_future().wait_for(std::chrono::seconds(10)));
+    later->cancel();
+}
 } // namespace asyncly
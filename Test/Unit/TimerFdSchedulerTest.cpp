@@ -0,0 +1,141 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#if defined(__linux__)
+
+#include "gmock/gmock.h"
+
+#include "asyncly/executor/ExternalEventExecutorController.h"
+#include "asyncly/executor/ThreadPoolExecutorController.h"
+#include "asyncly/scheduler/SchedulerThread.h"
+#include "asyncly/scheduler/TimerFdScheduler.h"
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+
+namespace asyncly {
+
+using namespace testing;
+
+namespace {
+bool isReadable(int fd)
+{
+    pollfd pfd{ fd, POLLIN, 0 };
+    return ::poll(&pfd, 1, 0) == 1;
+}
+} // namespace
+
+TEST(TimerFdSchedulerTest, shouldStopBeforeRun)
+{
+    TimerFdScheduler scheduler;
+    scheduler.stop();
+    scheduler.run();
+}
+
+TEST(TimerFdSchedulerTest, shouldSignalFdOnlyWhenTimersAreDue)
+{
+    const auto scheduler = std::make_shared<TimerFdScheduler>();
+    auto controller = ThreadPoolExecutorController::create(1);
+    auto executor = controller->get_executor();
+
+    EXPECT_FALSE(isReadable(scheduler->get_fd()));
+    scheduler->execute_after(executor, 1h, []() {});
+    EXPECT_FALSE(isReadable(scheduler->get_fd()));
+
+    std::promise<void> executed;
+    scheduler->execute_at(executor, scheduler->now(), [&executed]() { executed.set_value(); });
+    EXPECT_TRUE(isReadable(scheduler->get_fd()));
+
+    scheduler->runOnce();
+    executed.get_future().get();
+    EXPECT_FALSE(isReadable(scheduler->get_fd()));
+}
+
+TEST(TimerFdSchedulerTest, shouldRunTimersOfThreadPool)
+{
+    ThreadPoolConfig config;
+    config.executorInitFunctions.emplace_back([]() {});
+    config.schedulerFactory = []() { return std::make_shared<TimerFdScheduler>(); };
+    auto controller = ThreadPoolExecutorController::create(config);
+
+    std::promise<void> executed;
+    auto executor = controller->get_executor();
+    const auto start = executor->now();
+    executor->post_after(10ms, [&executed]() { executed.set_value(); });
+
+    executed.get_future().get();
+    EXPECT_GE(executor->now() - start, 10ms);
+}
+
+TEST(TimerFdSchedulerTest, shouldIntegrateIntoEventLoop)
+{
+    //! [TimerFdScheduler Event Loop]
+    const auto scheduler = std::make_shared<TimerFdScheduler>();
+    const auto taskFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    const auto controller = ExternalEventExecutorController::create(
+        [taskFd]() {
+            const std::uint64_t one = 1;
+            EXPECT_EQ(static_cast<ssize_t>(sizeof(one)), ::write(taskFd, &one, sizeof(one)));
+        },
+        {},
+        scheduler);
+
+    const auto loopFd = ::epoll_create1(EPOLL_CLOEXEC);
+    for (const auto fd : { taskFd, scheduler->get_fd() }) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(loopFd, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    auto done = false;
+    auto executor = controller->get_executor();
+    const auto start = executor->now();
+    executor->post_after(10ms, [&done]() { done = true; });
+
+    while (!done) {
+        epoll_event events[2];
+        const auto ready = ::epoll_wait(loopFd, events, 2, -1);
+        for (auto i = 0; i < ready; i++) {
+            if (events[i].data.fd == scheduler->get_fd()) {
+                scheduler->runOnce();
+            } else {
+                std::uint64_t count;
+                (void)::read(taskFd, &count, sizeof(count));
+                controller->runOnce();
+            }
+        }
+    }
+    //! [TimerFdScheduler Event Loop]
+
+    EXPECT_GE(executor->now() - start, 10ms);
+    ::close(loopFd);
+    ::close(taskFd);
+}
+
+} // namespace asyncly
+
+#endif
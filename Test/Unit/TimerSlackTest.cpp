@@ -0,0 +1,114 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "gmock/gmock.h"
+
+#include "asyncly/executor/SlackPost.h"
+#include "asyncly/test/FakeExecutor.h"
+
+#include <chrono>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace asyncly {
+
+using namespace testing;
+
+class TimerSlackTest : public Test {
+  public:
+    TimerSlackTest()
+        : executor_(test::FakeExecutor::create())
+        , scheduler_(std::dynamic_pointer_cast<test::FakeClockScheduler>(
+              executor_->get_scheduler()))
+        , start_(executor_->now())
+    {
+    }
+
+    Task record(int index)
+    {
+        return [this, index]() { executed_.push_back(index); };
+    }
+
+    // services the scheduler once, as a real scheduler does when it wakes up
+    void wakeUp()
+    {
+        scheduler_->advanceClockToNextEvent(clock_type::time_point::max());
+    }
+
+  protected:
+    std::shared_ptr<test::FakeExecutor> executor_;
+    std::shared_ptr<test::FakeClockScheduler> scheduler_;
+    const clock_type::time_point start_;
+    std::vector<int> executed_;
+};
+
+TEST_F(TimerSlackTest, shouldExpireOverlappingWindowsWithOneWakeup)
+{
+    //! [Post With Slack]
+    post_after(executor_, 10ms, 5ms, record(1));
+    post_after(executor_, 12ms, 5ms, record(2));
+    //! [Post With Slack]
+
+    wakeUp();
+    EXPECT_EQ(start_ + 15ms, executor_->now());
+    EXPECT_EQ(1u, executor_->queuedTasks());
+    executor_->runTasks();
+    EXPECT_THAT(executed_, ElementsAre(1, 2));
+    EXPECT_EQ(0u, executor_->queuedSchedulerTasks());
+}
+
+TEST_F(TimerSlackTest, shouldNotExpireTimersEarly)
+{
+    post_after(executor_, 10ms, 5ms, record(1));
+    post_after(executor_, 20ms, 0ms, record(2));
+
+    wakeUp();
+    EXPECT_EQ(start_ + 15ms, executor_->now());
+    executor_->runTasks();
+    EXPECT_THAT(executed_, ElementsAre(1));
+    EXPECT_EQ(1u, executor_->queuedSchedulerTasks());
+
+    wakeUp();
+    EXPECT_EQ(start_ + 20ms, executor_->now());
+    executor_->runTasks();
+    EXPECT_THAT(executed_, ElementsAre(1, 2));
+}
+
+TEST_F(TimerSlackTest, shouldPostTimersWithoutSlackOneByOne)
+{
+    executor_->post_after(10ms, record(1));
+    executor_->post_after(10ms, record(2));
+
+    wakeUp();
+    EXPECT_EQ(2u, executor_->queuedTasks());
+}
+
+TEST_F(TimerSlackTest, shouldNotRunCancelledTimerOfBatch)
+{
+    post_after(executor_, 10ms, 5ms, record(1));
+    auto cancelled = post_after(executor_, 12ms, 5ms, record(2));
+    post_after(executor_, 14ms, 5ms, record(3));
+
+    wakeUp();
+    EXPECT_TRUE(cancelled->cancel());
+    executor_->runTasks();
+    EXPECT_THAT(executed_, ElementsAre(1, 3));
+}
+
+} // namespace asyncly
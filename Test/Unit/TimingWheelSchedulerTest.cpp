@@ -0,0 +1,187 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "gmock/gmock.h"
+
+#include "asyncly/executor/ThreadPoolExecutorController.h"
+#include "asyncly/scheduler/TimingWheelScheduler.h"
+#include "asyncly/test/FakeExecutor.h"
+
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace asyncly {
+
+using namespace testing;
+
+class TimingWheelTest : public Test {
+  public:
+    TimingWheelTest()
+        : wheel_(std::make_shared<detail::TimingWheel>(
+            std::chrono::milliseconds(1), [this]() { return now_; }))
+        , executor_(test::FakeExecutor::create())
+    {
+    }
+
+    std::shared_ptr<Cancelable> addTask(int index, clock_type::duration relTime)
+    {
+        return wheel_->add(executor_, now_ + relTime, [this, index]() {
+            executed_.push_back(index);
+        });
+    }
+
+    void advance(clock_type::duration duration)
+    {
+        now_ += duration;
+        wheel_->elapse();
+        executor_->runTasks();
+    }
+
+  protected:
+    clock_type::time_point now_;
+    std::shared_ptr<detail::TimingWheel> wheel_;
+    std::shared_ptr<test::FakeExecutor> executor_;
+    std::vector<int> executed_;
+};
+
+TEST_F(TimingWheelTest, shouldExecuteTaskAtDeadline)
+{
+    addTask(1, std::chrono::milliseconds(5));
+
+    advance(std::chrono::milliseconds(4));
+    EXPECT_THAT(executed_, IsEmpty());
+    advance(std::chrono::milliseconds(1));
+    EXPECT_THAT(executed_, ElementsAre(1));
+    EXPECT_EQ(0u, wheel_->size());
+}
+
+TEST_F(TimingWheelTest, shouldNotExecuteTaskEarlyBetweenTicks)
+{
+    addTask(1, std::chrono::microseconds(1500));
+
+    advance(std::chrono::milliseconds(1));
+    EXPECT_THAT(executed_, IsEmpty());
+    advance(std::chrono::milliseconds(1));
+    EXPECT_THAT(executed_, ElementsAre(1));
+}
+
+TEST_F(TimingWheelTest, shouldExecuteTasksOnAllLevelsInOrder)
+{
+    const std::vector<clock_type::duration> deadlines{
+        std::chrono::milliseconds(70000), std::chrono::milliseconds(1),
+        std::chrono::milliseconds(256),   std::chrono::milliseconds(255),
+        std::chrono::milliseconds(65536), std::chrono::milliseconds(257),
+    };
+    for (auto i = 0u; i < deadlines.size(); i++) {
+        addTask(static_cast<int>(i), deadlines[i]);
+    }
+
+    auto elapsed = clock_type::duration::zero();
+    for (auto deadline : { 1, 255, 256, 257, 65536, 70000 }) {
+        advance(std::chrono::milliseconds(deadline - 1) - elapsed);
+        const auto executedBefore = executed_.size();
+        advance(std::chrono::milliseconds(1));
+        EXPECT_EQ(executedBefore + 1, executed_.size());
+        elapsed = std::chrono::milliseconds(deadline);
+    }
+    EXPECT_THAT(executed_, ElementsAre(1, 3, 2, 5, 4, 0));
+}
+
+TEST_F(TimingWheelTest, shouldExecutePastDeadlinesWithNextTick)
+{
+    advance(std::chrono::milliseconds(10));
+    addTask(1, -std::chrono::milliseconds(5));
+
+    advance(std::chrono::milliseconds(1));
+    EXPECT_THAT(executed_, ElementsAre(1));
+}
+
+TEST_F(TimingWheelTest, shouldRemoveCancelledTasks)
+{
+    auto first = addTask(1, std::chrono::milliseconds(5));
+    addTask(2, std::chrono::seconds(5));
+    EXPECT_EQ(2u, wheel_->size());
+
+    EXPECT_TRUE(first->cancel());
+    EXPECT_FALSE(first->cancel());
+    EXPECT_EQ(1u, wheel_->size());
+
+    advance(std::chrono::seconds(5));
+    EXPECT_THAT(executed_, ElementsAre(2));
+}
+
+TEST_F(TimingWheelTest, shouldNotExecuteTaskCancelledAfterExpiry)
+{
+    auto timer = addTask(1, std::chrono::milliseconds(5));
+    now_ += std::chrono::milliseconds(5);
+    wheel_->elapse();
+
+    EXPECT_TRUE(timer->cancel());
+    executor_->runTasks();
+    EXPECT_THAT(executed_, IsEmpty());
+}
+
+TEST_F(TimingWheelTest, shouldNotCancelExecutedTask)
+{
+    auto timer = addTask(1, std::chrono::milliseconds(5));
+    advance(std::chrono::milliseconds(5));
+
+    EXPECT_FALSE(timer->cancel());
+}
+
+TEST(TimingWheelSchedulerTest, shouldRunTimersOfThreadPool)
+{
+    //! [TimingWheelScheduler Factory]
+    ThreadPoolConfig config;
+    config.executorInitFunctions.emplace_back([]() {});
+    config.schedulerFactory = []() {
+        return std::make_shared<TimingWheelScheduler>(std::chrono::milliseconds(1));
+    };
+    auto controller = ThreadPoolExecutorController::create(config);
+    //! [TimingWheelScheduler Factory]
+
+    std::promise<void> executed;
+    auto executor = controller->get_executor();
+    const auto start = executor->now();
+    executor->post_after(std::chrono::milliseconds(10), [&executed]() { executed.set_value(); });
+
+    executed.get_future().get();
+    EXPECT_GE(executor->now() - start, std::chrono::milliseconds(10));
+}
+
+TEST(TimingWheelSchedulerTest, shouldWakeUpForEarlierTimerWhileWaitingForLaterOne)
+{
+    ThreadPoolConfig config;
+    config.executorInitFunctions.emplace_back([]() {});
+    config.schedulerFactory = []() {
+        return std::make_shared<TimingWheelScheduler>(std::chrono::milliseconds(1));
+    };
+    auto controller = ThreadPoolExecutorController::create(config);
+    auto executor = controller->get_executor();
+
+    executor->post_after(std::chrono::hours(1), []() {});
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    std::promise<void> executed;
+    executor->post_after(std::chrono::milliseconds(10), [&executed]() { executed.set_value(); });
+    EXPECT_EQ(std::future_status::ready, executed.get_future().wait_for(std::chrono::seconds(5)));
+}
+
+} // namespace asyncly
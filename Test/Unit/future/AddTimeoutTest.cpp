@@ -24,6 +24,7 @@
 #include "gmock/gmock.h"
 
 #include <chrono>
+#include <optional>
 
 namespace asyncly {
 
@@ -201,4 +202,53 @@ TYPED_TEST(AddTimeoutTest, shouldNotTimeoutErrorValueFuturesWithIndefiniteTimeou
     EXPECT_THROW(succeeded.get_future().get(), MyError);
 }
 
+TYPED_TEST(AddTimeoutTest, shouldCancelAugmentedFutureOnTimeout)
+{
+    std::promise<void> cancelled;
+    std::optional<Promise<int>> promise;
+
+    this->executor_->post([&cancelled, &promise]() {
+        auto lazy = make_lazy_future<int>();
+        promise.emplace(std::get<1>(lazy));
+        promise->on_cancel([&cancelled]() { cancelled.set_value(); });
+
+        add_timeout(std::chrono::milliseconds(0), std::get<0>(std::move(lazy)))
+            .then([](auto) { ADD_FAILURE(); });
+    });
+
+    EXPECT_NO_THROW(cancelled.get_future().get());
+}
+
+TYPED_TEST(AddTimeoutTest, shouldCancelAugmentedFutureWhenResultIsCancelled)
+{
+    std::promise<void> cancelled;
+    std::optional<Promise<void>> promise;
+
+    this->executor_->post([&cancelled, &promise]() {
+        auto lazy = make_lazy_future<void>();
+        promise.emplace(std::get<1>(lazy));
+        promise->on_cancel([&cancelled]() { cancelled.set_value(); });
+
+        auto result = add_timeout(std::chrono::hours(100), std::get<0>(std::move(lazy)));
+        result.catch_error([](auto error) {
+            EXPECT_THROW(std::rethrow_exception(error), Cancelled);
+        });
+        result.cancel();
+    });
+
+    EXPECT_NO_THROW(cancelled.get_future().get());
+}
+
+TYPED_TEST(AddTimeoutTest, shouldPropagateMoveOnlyValues)
+{
+    std::promise<int> succeeded;
+
+    this->executor_->post([&succeeded]() {
+        add_timeout(std::chrono::hours(100), make_ready_future(std::make_unique<int>(5)))
+            .then([&succeeded](std::unique_ptr<int> value) { succeeded.set_value(*value); });
+    });
+
+    EXPECT_EQ(5, succeeded.get_future().get());
+}
+
 } // namespace asyncly
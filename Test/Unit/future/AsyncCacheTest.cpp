@@ -0,0 +1,202 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "asyncly/future/AsyncCache.h"
+
+#include "asyncly/test/FakeFutureTest.h"
+
+#include "gmock/gmock.h"
+
+#include <chrono>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace asyncly {
+
+using namespace testing;
+
+class AsyncCacheTest : public test::FakeFutureTest {
+  public:
+    // loads are resolved explicitly by the tests through resolve() or fail()
+    AsyncCache<int, std::string>::loader_t loader()
+    {
+        return [this](const int& key) {
+            loads_[key]++;
+            auto lazy = make_lazy_future<std::string>();
+            promises_.emplace_back(key, std::get<1>(lazy));
+            return std::get<0>(lazy);
+        };
+    }
+
+    void resolve()
+    {
+        auto promises = std::move(promises_);
+        for (auto& [key, promise] : promises) {
+            promise.set_value(std::to_string(key));
+        }
+        get_fake_executor()->runTasks();
+    }
+
+    void fail()
+    {
+        auto promises = std::move(promises_);
+        for (auto& entry : promises) {
+            entry.second.set_exception(std::runtime_error{ "load failed" });
+        }
+        get_fake_executor()->runTasks();
+    }
+
+  protected:
+    std::map<int, int> loads_;
+    std::vector<std::pair<int, Promise<std::string>>> promises_;
+};
+
+TEST_F(AsyncCacheTest, shouldShareOneLoadBetweenConcurrentMisses)
+{
+    //! [AsyncCache Get]
+    AsyncCache<int, std::string> cache{ loader() };
+
+    auto first = cache.get(1);
+    auto second = cache.get(1);
+    //! [AsyncCache Get]
+    resolve();
+
+    auto firstValue = wait_for_future(std::move(first));
+    auto secondValue = wait_for_future(std::move(second));
+    EXPECT_EQ("1", *firstValue);
+    EXPECT_EQ(firstValue.get(), secondValue.get());
+    EXPECT_EQ(1, loads_[1]);
+}
+
+TEST_F(AsyncCacheTest, shouldServeLoadedValuesFromCache)
+{
+    AsyncCache<int, std::string> cache{ loader() };
+    auto first = cache.get(1);
+    resolve();
+    auto firstValue = wait_for_future(std::move(first));
+
+    auto secondValue = wait_for_future(cache.get(1));
+
+    EXPECT_EQ(firstValue.get(), secondValue.get());
+    EXPECT_EQ(1, loads_[1]);
+}
+
+TEST_F(AsyncCacheTest, shouldExpireEntriesAfterTtl)
+{
+    AsyncCache<int, std::string> cache{ loader(), { std::chrono::seconds(10) } };
+    auto future = cache.get(1);
+    resolve();
+    wait_for_future(std::move(future));
+
+    get_fake_executor()->advanceClock(std::chrono::seconds(9));
+    EXPECT_EQ(1u, cache.size());
+    get_fake_executor()->advanceClock(std::chrono::seconds(1));
+    EXPECT_EQ(0u, cache.size());
+
+    auto reloaded = cache.get(1);
+    resolve();
+    EXPECT_EQ("1", *wait_for_future(std::move(reloaded)));
+    EXPECT_EQ(2, loads_[1]);
+}
+
+TEST_F(AsyncCacheTest, shouldEvictLeastRecentlyUsedEntries)
+{
+    AsyncCache<int, std::string> cache{ loader(), { std::nullopt, 2 } };
+    cache.get(1);
+    cache.get(2);
+    resolve();
+
+    cache.get(1);
+    cache.get(3);
+    resolve();
+    EXPECT_EQ(2u, cache.size());
+
+    cache.get(1);
+    cache.get(2);
+    resolve();
+
+    EXPECT_EQ(1, loads_[1]);
+    EXPECT_EQ(2, loads_[2]);
+    EXPECT_EQ(1, loads_[3]);
+}
+
+TEST_F(AsyncCacheTest, shouldResolveWaitersOfEvictedLoads)
+{
+    AsyncCache<int, std::string> cache{ loader(), { std::nullopt, 1 } };
+    auto first = cache.get(1);
+    cache.get(2);
+    EXPECT_EQ(1u, cache.size());
+
+    resolve();
+
+    EXPECT_EQ("1", *wait_for_future(std::move(first)));
+}
+
+TEST_F(AsyncCacheTest, shouldNotCacheFailedLoads)
+{
+    AsyncCache<int, std::string> cache{ loader() };
+    auto first = cache.get(1);
+    auto second = cache.get(1);
+    fail();
+
+    EXPECT_THROW(wait_for_future(std::move(first)), std::runtime_error);
+    EXPECT_THROW(wait_for_future(std::move(second)), std::runtime_error);
+    EXPECT_EQ(0u, cache.size());
+
+    auto third = cache.get(1);
+    resolve();
+    EXPECT_EQ("1", *wait_for_future(std::move(third)));
+    EXPECT_EQ(2, loads_[1]);
+}
+
+TEST_F(AsyncCacheTest, shouldNotCacheLoaderExceptions)
+{
+    auto calls = 0;
+    AsyncCache<int, std::string> cache{ [&calls](const int&) -> Future<std::string> {
+        calls++;
+        throw std::runtime_error{ "no loader" };
+    } };
+
+    EXPECT_THROW(wait_for_future(cache.get(1)), std::runtime_error);
+    EXPECT_THROW(wait_for_future(cache.get(1)), std::runtime_error);
+    EXPECT_EQ(2, calls);
+}
+
+TEST_F(AsyncCacheTest, shouldReloadInvalidatedEntries)
+{
+    AsyncCache<int, std::string> cache{ loader(), { std::chrono::seconds(10) } };
+    cache.get(1);
+    resolve();
+
+    cache.invalidate(1);
+    EXPECT_EQ(0u, cache.size());
+
+    cache.get(1);
+    resolve();
+    EXPECT_EQ(2, loads_[1]);
+}
+
+TEST_F(AsyncCacheTest, shouldRejectEmptyCapacity)
+{
+    EXPECT_THROW(
+        (AsyncCache<int, std::string>{ loader(), { std::nullopt, 0 } }), std::invalid_argument);
+}
+
+} // namespace asyncly
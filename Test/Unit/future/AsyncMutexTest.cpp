@@ -0,0 +1,191 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "asyncly/future/AsyncMutex.h"
+
+#include "StrandImplTestFactory.h"
+#include "asyncly/test/ExecutorTestFactories.h"
+
+#include "gmock/gmock.h"
+
+#include <future>
+#include <mutex>
+#include <vector>
+
+namespace asyncly {
+
+using namespace testing;
+
+template <typename TExecutorFactory> class AsyncMutexTest : public Test {
+  public:
+    AsyncMutexTest()
+        : factory_(std::make_unique<TExecutorFactory>())
+        , executor_(factory_->create())
+    {
+    }
+
+    std::unique_ptr<TExecutorFactory> factory_;
+    std::shared_ptr<IExecutor> executor_;
+};
+
+using ExecutorFactoryTypes = ::testing::Types<
+    asyncly::test::AsioExecutorFactory<>,
+    asyncly::test::DefaultExecutorFactory<>,
+    asyncly::test::DefaultExecutorFactory<4>,
+    asyncly::test::StrandImplTestFactory<>>;
+
+TYPED_TEST_SUITE(AsyncMutexTest, ExecutorFactoryTypes);
+
+TYPED_TEST(AsyncMutexTest, shouldLockUnlockedMutexRightAway)
+{
+    AsyncMutex mutex;
+    std::promise<void> locked;
+
+    this->executor_->post([&mutex, &locked]() {
+        mutex.lock().then([&mutex, &locked](AsyncMutex::Guard guard) {
+            EXPECT_TRUE(guard);
+            EXPECT_FALSE(mutex.try_lock());
+            guard.unlock();
+            EXPECT_TRUE(mutex.try_lock());
+            locked.set_value();
+        });
+    });
+
+    EXPECT_NO_THROW(locked.get_future().get());
+}
+
+TYPED_TEST(AsyncMutexTest, shouldHandLockToWaitersInOrder)
+{
+    AsyncMutex mutex;
+    std::mutex orderMutex;
+    std::vector<int> order;
+    std::promise<void> done;
+
+    this->executor_->post([&mutex, &orderMutex, &order, &done]() {
+        auto guard = mutex.try_lock();
+        ASSERT_TRUE(guard);
+        for (auto i = 0; i < 5; i++) {
+            mutex.lock().then([i, &orderMutex, &order, &done](AsyncMutex::Guard guard) {
+                auto finished = false;
+                {
+                    std::lock_guard<std::mutex> lock{ orderMutex };
+                    order.push_back(i);
+                    finished = order.size() == 5;
+                }
+                guard.unlock();
+                if (finished) {
+                    done.set_value();
+                }
+            });
+        }
+        guard->unlock();
+    });
+
+    done.get_future().get();
+    EXPECT_THAT(order, ElementsAre(0, 1, 2, 3, 4));
+}
+
+TYPED_TEST(AsyncMutexTest, shouldSkipCancelledWaiters)
+{
+    AsyncMutex mutex;
+    std::promise<void> done;
+
+    this->executor_->post([&mutex, &done]() {
+        auto guard = mutex.try_lock();
+        auto cancelled = mutex.lock();
+        mutex.lock().then([&done](AsyncMutex::Guard guard) {
+            guard.unlock();
+            done.set_value();
+        });
+        cancelled.cancel();
+        guard->unlock();
+    });
+
+    done.get_future().get();
+    EXPECT_TRUE(mutex.try_lock());
+}
+
+TYPED_TEST(AsyncMutexTest, shouldProvideMutualExclusionAcrossAsynchronousSteps)
+{
+    const auto iterations = 200;
+    AsyncMutex mutex;
+    auto executor = this->executor_;
+    auto inside = 0;
+    auto maxInside = 0;
+    auto counter = 0;
+    std::promise<void> done;
+
+    for (auto i = 0; i < iterations; i++) {
+        executor->post([&, executor]() {
+            mutex.lock().then([&, executor](AsyncMutex::Guard guard) {
+                maxInside = std::max(maxInside, ++inside);
+                auto lazy = make_lazy_future<void>();
+                // the critical section spans a hop through the executor
+                executor->post([promise = std::get<1>(lazy)]() mutable { promise.set_value(); });
+                std::get<0>(lazy).then(
+                    [&, guard = std::make_shared<AsyncMutex::Guard>(std::move(guard))]() {
+                        inside--;
+                        auto finished = ++counter == iterations;
+                        guard->unlock();
+                        if (finished) {
+                            done.set_value();
+                        }
+                    });
+            });
+        });
+    }
+
+    done.get_future().get();
+    EXPECT_EQ(1, maxInside);
+    EXPECT_EQ(iterations, counter);
+}
+
+#ifdef ASYNCLY_HAS_COROUTINES
+TYPED_TEST(AsyncMutexTest, shouldLockAcrossCoAwait)
+{
+    // the guard of the last coroutine is only destroyed after it has resolved its Future
+    auto mutex = std::make_shared<AsyncMutex>();
+    auto executor = this->executor_;
+    auto shared = std::make_shared<std::vector<int>>();
+    auto done = std::make_shared<std::promise<void>>();
+
+    //! [AsyncMutex Coroutine]
+    auto appendTwice = [](auto mutex, auto shared, int value) -> Future<void> {
+        auto guard = co_await mutex->lock();
+        shared->push_back(value);
+        co_await make_ready_future();
+        shared->push_back(value);
+    };
+    //! [AsyncMutex Coroutine]
+
+    executor->post([mutex, &appendTwice, shared, done]() {
+        [](auto mutex, auto& appendTwice, auto shared, auto done) -> Future<void> {
+            auto first = appendTwice(mutex, shared, 1);
+            auto second = appendTwice(mutex, shared, 2);
+            co_await first;
+            co_await second;
+            done->set_value();
+        }(mutex, appendTwice, shared, done);
+    });
+
+    done->get_future().get();
+    EXPECT_THAT(*shared, ElementsAre(1, 1, 2, 2));
+}
+#endif
+
+} // namespace asyncly
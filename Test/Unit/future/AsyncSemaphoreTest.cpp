@@ -0,0 +1,226 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "asyncly/future/AsyncSemaphore.h"
+#include "asyncly/future/WhenAll.h"
+
+#include "StrandImplTestFactory.h"
+#include "asyncly/executor/ThreadPoolExecutorController.h"
+#include "asyncly/test/ExecutorTestFactories.h"
+
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace asyncly {
+
+using namespace testing;
+
+template <typename TExecutorFactory> class AsyncSemaphoreTest : public Test {
+  public:
+    AsyncSemaphoreTest()
+        : factory_(std::make_unique<TExecutorFactory>())
+        , executor_(factory_->create())
+    {
+    }
+
+    std::unique_ptr<TExecutorFactory> factory_;
+    std::shared_ptr<IExecutor> executor_;
+};
+
+using ExecutorFactoryTypes = ::testing::Types<
+    asyncly::test::AsioExecutorFactory<>,
+    asyncly::test::DefaultExecutorFactory<>,
+    asyncly::test::StrandImplTestFactory<>>;
+
+TYPED_TEST_SUITE(AsyncSemaphoreTest, ExecutorFactoryTypes);
+
+TYPED_TEST(AsyncSemaphoreTest, shouldHandOutAvailablePermitsRightAway)
+{
+    AsyncSemaphore semaphore{ 2 };
+    std::promise<void> acquired;
+
+    //! [AsyncSemaphore Acquire]
+    this->executor_->post([&semaphore, &acquired]() {
+        semaphore.acquire().then([&semaphore, &acquired](AsyncSemaphore::Permit permit) {
+            EXPECT_TRUE(permit);
+            EXPECT_EQ(1u, semaphore.available());
+            // the permit is returned to the semaphore as soon as it goes out of scope
+            permit.release();
+            EXPECT_EQ(2u, semaphore.available());
+            acquired.set_value();
+        });
+    });
+    //! [AsyncSemaphore Acquire]
+
+    EXPECT_NO_THROW(acquired.get_future().get());
+}
+
+TYPED_TEST(AsyncSemaphoreTest, shouldServeWaitersInOrder)
+{
+    AsyncSemaphore semaphore{ 1 };
+    std::mutex mutex;
+    std::vector<int> order;
+    std::promise<void> done;
+
+    this->executor_->post([&semaphore, &mutex, &order, &done]() {
+        auto first = semaphore.try_acquire();
+        ASSERT_TRUE(first);
+        for (auto i = 0; i < 5; i++) {
+            semaphore.acquire().then(
+                [i, &mutex, &order, &done](AsyncSemaphore::Permit permit) {
+                    bool last = false;
+                    {
+                        std::lock_guard<std::mutex> lock{ mutex };
+                        order.push_back(i);
+                        last = order.size() == 5;
+                    }
+                    // the test may return as soon as done is set, so nothing on its stack
+                    // must be touched afterwards
+                    permit.release();
+                    if (last) {
+                        done.set_value();
+                    }
+                });
+        }
+        EXPECT_FALSE(semaphore.try_acquire());
+        first->release();
+    });
+
+    done.get_future().get();
+    EXPECT_THAT(order, ElementsAre(0, 1, 2, 3, 4));
+}
+
+TYPED_TEST(AsyncSemaphoreTest, shouldSkipCancelledWaiters)
+{
+    AsyncSemaphore semaphore{ 1 };
+    std::promise<void> done;
+
+    this->executor_->post([&semaphore, &done]() {
+        auto first = semaphore.try_acquire();
+        auto cancelled = semaphore.acquire();
+        semaphore.acquire().then([&done](AsyncSemaphore::Permit permit) {
+            permit.release();
+            done.set_value();
+        });
+        cancelled.cancel();
+        first->release();
+    });
+
+    EXPECT_NO_THROW(done.get_future().get());
+    EXPECT_EQ(1u, semaphore.available());
+}
+
+TYPED_TEST(AsyncSemaphoreTest, shouldResumeWaitersOnTheirOwnExecutor)
+{
+    AsyncSemaphore semaphore{ 1 };
+    auto otherController = ThreadPoolExecutorController::create(1);
+    auto other = otherController->get_executor();
+    std::promise<std::thread::id> otherThread;
+    std::promise<std::thread::id> resumedOn;
+    auto held = semaphore.try_acquire();
+
+    other->post([&semaphore, &otherThread, &resumedOn]() {
+        otherThread.set_value(std::this_thread::get_id());
+        semaphore.acquire().then([&resumedOn](AsyncSemaphore::Permit) {
+            resumedOn.set_value(std::this_thread::get_id());
+        });
+    });
+
+    auto expected = otherThread.get_future().get();
+    this->executor_->post([&held]() { held.reset(); });
+
+    EXPECT_EQ(expected, resumedOn.get_future().get());
+    otherController->finish();
+}
+
+TYPED_TEST(AsyncSemaphoreTest, shouldLimitConcurrency)
+{
+    std::vector<Promise<int>> producers;
+    std::atomic<int> running{ 0 };
+    std::atomic<int> maxRunning{ 0 };
+    std::promise<int> sum;
+
+    this->executor_->post([&producers, &running, &maxRunning, &sum]() {
+        //! [AsyncSemaphore Concurrency Limit]
+        auto limited = with_concurrency_limit(2, [&](int value) {
+            maxRunning = std::max(maxRunning.load(), ++running);
+            auto lazy = make_lazy_future<int>();
+            producers.push_back(std::get<1>(lazy));
+            return std::get<0>(lazy).then([&running, value](int offset) {
+                running--;
+                return value + offset;
+            });
+        });
+        //! [AsyncSemaphore Concurrency Limit]
+
+        std::vector<Future<int>> results;
+        for (auto i = 0; i < 6; i++) {
+            results.push_back(limited(i));
+        }
+        when_all(std::move(results)).then([&sum](std::vector<int> values) {
+            sum.set_value(std::accumulate(values.begin(), values.end(), 0));
+        });
+    });
+
+    // resolve producers one by one as they are started
+    auto resolved = std::size_t{ 0 };
+    while (resolved < 6) {
+        std::promise<std::optional<Promise<int>>> next;
+        this->executor_->post([&producers, &next, resolved]() {
+            next.set_value(
+                resolved < producers.size() ? std::optional{ producers[resolved] } : std::nullopt);
+        });
+        if (auto producer = next.get_future().get()) {
+            producer->set_value(10);
+            resolved++;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    EXPECT_EQ(0 + 1 + 2 + 3 + 4 + 5 + 60, sum.get_future().get());
+    EXPECT_EQ(2, maxRunning.load());
+}
+
+#ifdef ASYNCLY_HAS_COROUTINES
+TYPED_TEST(AsyncSemaphoreTest, shouldAcquireWithCoroutine)
+{
+    AsyncSemaphore semaphore{ 1 };
+    auto available = std::make_shared<std::promise<std::size_t>>();
+
+    this->executor_->post([&semaphore, available]() {
+        [](auto& semaphore, auto available) -> Future<void> {
+            auto permit = co_await semaphore.acquire();
+            available->set_value(semaphore.available());
+        }(semaphore, available);
+    });
+
+    EXPECT_EQ(0u, available->get_future().get());
+}
+#endif
+
+} // namespace asyncly
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "asyncly/future/Batcher.h"
+
+#include "asyncly/test/FakeFutureTest.h"
+
+#include "gmock/gmock.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+namespace asyncly {
+
+using namespace testing;
+
+class BatcherTest : public test::FakeFutureTest {
+  public:
+    Batcher<int, int>::batch_function_t doubling()
+    {
+        return [this](std::vector<int> requests) {
+            batches_.push_back(requests);
+            for (auto& request : requests) {
+                request *= 2;
+            }
+            return make_ready_future(std::move(requests));
+        };
+    }
+
+  protected:
+    std::vector<std::vector<int>> batches_;
+};
+
+TEST_F(BatcherTest, shouldDispatchFullBatch)
+{
+    //! [Batcher Submit]
+    auto doubleAll = [](std::vector<int> requests) {
+        for (auto& request : requests) {
+            request *= 2;
+        }
+        return make_ready_future(std::move(requests));
+    };
+    Batcher<int, int> batcher{ doubleAll, { 3, std::chrono::milliseconds(5) } };
+
+    auto first = batcher.submit(1);
+    auto second = batcher.submit(2);
+    auto third = batcher.submit(3);
+    //! [Batcher Submit]
+
+    EXPECT_EQ(2, wait_for_future(std::move(first)));
+    EXPECT_EQ(4, wait_for_future(std::move(second)));
+    EXPECT_EQ(6, wait_for_future(std::move(third)));
+}
+
+TEST_F(BatcherTest, shouldDispatchBatchAtDeadline)
+{
+    Batcher<int, int> batcher{ doubling(), { 10, std::chrono::milliseconds(5) } };
+    auto first = batcher.submit(1);
+    auto second = batcher.submit(2);
+
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(4));
+    EXPECT_TRUE(batches_.empty());
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(1));
+
+    EXPECT_THAT(batches_, ElementsAre(ElementsAre(1, 2)));
+    EXPECT_EQ(2, wait_for_future(std::move(first)));
+    EXPECT_EQ(4, wait_for_future(std::move(second)));
+}
+
+TEST_F(BatcherTest, shouldStartNewDeadlineForNextBatch)
+{
+    Batcher<int, int> batcher{ doubling(), { 2, std::chrono::milliseconds(5) } };
+    batcher.submit(1);
+    batcher.submit(2);
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(3));
+    batcher.submit(3);
+
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(4));
+    EXPECT_THAT(batches_, ElementsAre(ElementsAre(1, 2)));
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(1));
+    EXPECT_THAT(batches_, ElementsAre(ElementsAre(1, 2), ElementsAre(3)));
+}
+
+TEST_F(BatcherTest, shouldDispatchOnFlush)
+{
+    Batcher<int, int> batcher{ doubling(), { 10, std::chrono::seconds(1) } };
+    auto future = batcher.submit(1);
+
+    batcher.flush();
+    batcher.flush();
+
+    EXPECT_EQ(2, wait_for_future(std::move(future)));
+    EXPECT_EQ(1u, batches_.size());
+}
+
+TEST_F(BatcherTest, shouldDispatchPendingRequestsOnDestruction)
+{
+    auto future = [this]() {
+        Batcher<int, int> batcher{ doubling(), { 10, std::chrono::seconds(1) } };
+        return batcher.submit(1);
+    }();
+
+    EXPECT_EQ(2, wait_for_future(std::move(future)));
+}
+
+TEST_F(BatcherTest, shouldRejectAllRequestsWhenBatchFails)
+{
+    auto failing = [](std::vector<int>) {
+        return make_exceptional_future<std::vector<int>>(std::runtime_error{ "batch failed" });
+    };
+    Batcher<int, int> batcher{ failing, { 2, std::chrono::seconds(1) } };
+
+    auto first = batcher.submit(1);
+    auto second = batcher.submit(2);
+
+    EXPECT_THROW(wait_for_future(std::move(first)), std::runtime_error);
+    EXPECT_THROW(wait_for_future(std::move(second)), std::runtime_error);
+}
+
+TEST_F(BatcherTest, shouldRejectAllRequestsWhenResponseCountDiffers)
+{
+    auto tooFew = [](std::vector<int>) { return make_ready_future(std::vector<int>{ 1 }); };
+    Batcher<int, int> batcher{ tooFew, { 2, std::chrono::seconds(1) } };
+
+    auto first = batcher.submit(1);
+    auto second = batcher.submit(2);
+
+    EXPECT_THROW(wait_for_future(std::move(first)), std::runtime_error);
+    EXPECT_THROW(wait_for_future(std::move(second)), std::runtime_error);
+}
+
+TEST_F(BatcherTest, shouldLeaveOutCancelledRequests)
+{
+    Batcher<int, int> batcher{ doubling(), { 3, std::chrono::seconds(1) } };
+    auto first = batcher.submit(1);
+    first.cancel();
+    auto second = batcher.submit(2);
+    auto third = batcher.submit(3);
+
+    EXPECT_EQ(4, wait_for_future(std::move(second)));
+    EXPECT_EQ(6, wait_for_future(std::move(third)));
+    EXPECT_THAT(batches_, ElementsAre(ElementsAre(2, 3)));
+}
+
+} // namespace asyncly
@@ -0,0 +1,262 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "asyncly/future/Channel.h"
+
+#include "StrandImplTestFactory.h"
+#include "asyncly/executor/ThreadPoolExecutorController.h"
+#include "asyncly/future/BlockingWait.h"
+#include "asyncly/test/ExecutorTestFactories.h"
+
+#include "gmock/gmock.h"
+
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace asyncly {
+
+using namespace testing;
+
+template <typename TExecutorFactory> class ChannelTest : public Test {
+  public:
+    ChannelTest()
+        : factory_(std::make_unique<TExecutorFactory>())
+        , executor_(factory_->create())
+    {
+    }
+
+    // waits until everything posted to the executor so far has been run
+    void flush()
+    {
+        std::promise<void> flushed;
+        executor_->post([&flushed]() { flushed.set_value(); });
+        flushed.get_future().get();
+    }
+
+    std::unique_ptr<TExecutorFactory> factory_;
+    std::shared_ptr<IExecutor> executor_;
+};
+
+using ExecutorFactoryTypes = ::testing::Types<
+    asyncly::test::AsioExecutorFactory<>,
+    asyncly::test::DefaultExecutorFactory<>,
+    asyncly::test::StrandImplTestFactory<>>;
+
+TYPED_TEST_SUITE(ChannelTest, ExecutorFactoryTypes);
+
+TYPED_TEST(ChannelTest, shouldReceiveValuesInSendOrder)
+{
+    Channel<int> channel{ 4 };
+    std::vector<int> received;
+
+    this->executor_->post([&channel, &received]() {
+        for (auto i = 0; i < 3; i++) {
+            channel.send(i);
+        }
+        for (auto i = 0; i < 3; i++) {
+            channel.receive().then([&received](int value) { received.push_back(value); });
+        }
+    });
+    this->flush();
+    this->flush();
+
+    EXPECT_THAT(received, ElementsAre(0, 1, 2));
+}
+
+TYPED_TEST(ChannelTest, shouldHandValueToWaitingReceiver)
+{
+    Channel<std::unique_ptr<int>> channel{ 1 };
+    std::promise<int> received;
+
+    this->executor_->post([&channel, &received]() {
+        channel.receive().then(
+            [&received](std::unique_ptr<int> value) { received.set_value(*value); });
+        channel.send(std::make_unique<int>(42));
+    });
+
+    EXPECT_EQ(42, received.get_future().get());
+    EXPECT_EQ(0u, channel.size());
+}
+
+TYPED_TEST(ChannelTest, shouldApplyBackpressureWhenFull)
+{
+    Channel<int> channel{ 2 };
+    auto sent = std::make_shared<std::vector<int>>();
+
+    this->executor_->post([&channel, sent]() {
+        for (auto i = 0; i < 3; i++) {
+            channel.send(i).then([sent, i]() { sent->push_back(i); });
+        }
+    });
+    this->flush();
+    this->flush();
+    EXPECT_THAT(*sent, ElementsAre(0, 1));
+    EXPECT_EQ(3u, channel.size());
+
+    std::promise<int> received;
+    this->executor_->post([&channel, &received]() {
+        channel.receive().then([&received](int value) { received.set_value(value); });
+    });
+    EXPECT_EQ(0, received.get_future().get());
+    this->flush();
+    EXPECT_THAT(*sent, ElementsAre(0, 1, 2));
+    EXPECT_EQ(2u, channel.size());
+}
+
+TYPED_TEST(ChannelTest, shouldRendezvousWithoutCapacity)
+{
+    Channel<int> channel{ 0 };
+    auto sent = std::make_shared<bool>(false);
+    std::promise<int> received;
+
+    this->executor_->post([&channel, sent]() { channel.send(7).then([sent]() { *sent = true; }); });
+    this->flush();
+    this->flush();
+    EXPECT_FALSE(*sent);
+
+    this->executor_->post([&channel, &received]() {
+        channel.receive().then([&received](int value) { received.set_value(value); });
+    });
+    EXPECT_EQ(7, received.get_future().get());
+    this->flush();
+    EXPECT_TRUE(*sent);
+}
+
+TYPED_TEST(ChannelTest, shouldReceiveBufferedAndWaitingValuesInOneBatch)
+{
+    Channel<int> channel{ 2 };
+    std::promise<std::vector<int>> batch;
+
+    this->executor_->post([&channel, &batch]() {
+        for (auto i = 0; i < 5; i++) {
+            channel.send(i);
+        }
+        channel.receive_batch(4).then(
+            [&batch](std::vector<int> values) { batch.set_value(std::move(values)); });
+    });
+
+    EXPECT_THAT(batch.get_future().get(), ElementsAre(0, 1, 2, 3));
+    EXPECT_EQ(1u, channel.size());
+}
+
+TYPED_TEST(ChannelTest, shouldDrainClosedChannel)
+{
+    Channel<int> channel{ 2 };
+    std::promise<int> value;
+    std::promise<bool> receiveRejected;
+    std::promise<bool> sendRejected;
+
+    this->executor_->post([&]() {
+        channel.send(1);
+        channel.close();
+        channel.send(2).catch_error(
+            [&sendRejected](std::exception_ptr) { sendRejected.set_value(true); });
+        channel.receive().then([&value](int v) { value.set_value(v); });
+        channel.receive().catch_error(
+            [&receiveRejected](std::exception_ptr) { receiveRejected.set_value(true); });
+    });
+
+    EXPECT_EQ(1, value.get_future().get());
+    EXPECT_TRUE(sendRejected.get_future().get());
+    EXPECT_TRUE(receiveRejected.get_future().get());
+}
+
+TYPED_TEST(ChannelTest, shouldRejectWaitingReceiversOnClose)
+{
+    Channel<int> channel{ 2 };
+    std::promise<void> rejected;
+
+    this->executor_->post([&channel, &rejected]() {
+        channel.receive().then([](int) { ADD_FAILURE(); }).catch_error([&rejected](auto error) {
+            try {
+                std::rethrow_exception(error);
+            } catch (const ChannelClosed&) {
+                rejected.set_value();
+            }
+        });
+        channel.close();
+    });
+
+    EXPECT_NO_THROW(rejected.get_future().get());
+}
+
+TEST(ChannelCancelTest, shouldNotLoseValueWhenReceiverIsCancelledDuringSend)
+{
+    for (auto i = 0; i < 1000; i++) {
+        Channel<int> channel{ 1 };
+        auto received = channel.receive();
+
+        std::thread canceller{ [&received]() { received.cancel(); } };
+        channel.send(i);
+        canceller.join();
+
+        // the value is either buffered because the receiver has been cancelled first, or it has
+        // been received
+        if (channel.size() == 0) {
+            EXPECT_EQ(i, blocking_wait(std::move(received)));
+        } else {
+            EXPECT_EQ(i, blocking_wait(channel.receive()));
+        }
+    }
+}
+
+namespace {
+// sends `count` values one after the other, each as soon as the previous one was accepted
+void produce(Channel<int>& channel, int next, int count)
+{
+    if (next == count) {
+        channel.close();
+        return;
+    }
+    channel.send(next).then([&channel, next, count]() { produce(channel, next + 1, count); });
+}
+
+void consume(Channel<int>& channel, std::shared_ptr<std::promise<long>> sum, long partial)
+{
+    channel.receive_batch(64)
+        .then([&channel, sum, partial](std::vector<int> values) {
+            auto total = partial;
+            for (auto value : values) {
+                total += value;
+            }
+            consume(channel, sum, total);
+        })
+        .catch_error([sum, partial](std::exception_ptr) { sum->set_value(partial); });
+}
+} // namespace
+
+TYPED_TEST(ChannelTest, shouldConnectStagesOnDifferentExecutors)
+{
+    auto consumerController = ThreadPoolExecutorController::create(1);
+    auto consumer = consumerController->get_executor();
+    auto sum = std::make_shared<std::promise<long>>();
+    const auto count = 1000;
+
+    //! [Channel Pipeline]
+    Channel<int> channel{ 16 };
+    this->executor_->post([&channel, count]() { produce(channel, 0, count); });
+    consumer->post([&channel, sum]() { consume(channel, sum, 0); });
+    //! [Channel Pipeline]
+
+    EXPECT_EQ(count * (count - 1) / 2, sum->get_future().get());
+    consumerController->finish();
+}
+
+} // namespace asyncly
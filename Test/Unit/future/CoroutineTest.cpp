@@ -210,5 +210,28 @@ TYPED_TEST(CoroutineTest, shouldThrowOnSecondCoroutineAsyncAwaitOfReadyVoidFutur
 
     EXPECT_ANY_THROW(value->get_future().get());
 }
+
+TYPED_TEST(CoroutineTest, shouldCancelAwaitedFutureWhenCoroutineIsCancelled)
+{
+    auto cancelled = std::make_shared<std::promise<void>>();
+
+    auto lazy = make_lazy_future<int>();
+    auto future = std::get<0>(lazy);
+    auto promise = std::get<1>(lazy);
+
+    this->executor_->post([&cancelled, &future]() {
+        auto coroutine = [](auto& cancelled, auto& future) -> Future<void> {
+            try {
+                co_await future;
+            } catch (const Cancelled&) {
+                cancelled->set_value();
+            }
+        }(cancelled, future);
+        coroutine.cancel();
+    });
+
+    EXPECT_NO_THROW(cancelled->get_future().get());
+    EXPECT_TRUE(promise.is_cancelled());
+}
 #endif
 } // namespace asyncly
@@ -18,6 +18,7 @@
 
 #include <chrono>
 #include <future>
+#include <optional>
 #include <thread>
 
 #include "gmock/gmock.h"
@@ -1401,6 +1402,127 @@ TYPED_TEST(FutureTest, thenShouldHoldExecutorReference)
     }
 }
 
+TYPED_TEST(FutureTest, shouldRejectCancelledFuture)
+{
+    std::promise<void> rejected;
+
+    this->executor_->post([&rejected]() {
+        auto lazy = make_lazy_future<int>();
+        auto future = std::get<0>(lazy);
+        auto promise = std::get<1>(lazy);
+
+        future.catch_error([&rejected](auto e) { rejected.set_exception(e); });
+        future.cancel();
+
+        EXPECT_TRUE(promise.is_cancelled());
+        EXPECT_NO_THROW(promise.set_value(42));
+    });
+
+    EXPECT_THROW(rejected.get_future().get(), Cancelled);
+}
+
+TYPED_TEST(FutureTest, shouldPropagateCancellationToPromise)
+{
+    std::promise<void> cancelled;
+
+    this->executor_->post([&cancelled]() {
+        auto lazy = make_lazy_future<int>();
+        auto promise = std::get<1>(lazy);
+        promise.on_cancel([&cancelled]() { cancelled.set_value(); });
+
+        auto continued = std::get<0>(lazy).then([](int) { ADD_FAILURE(); }).then([]() {
+            ADD_FAILURE();
+        });
+        continued.cancel();
+        promise.set_value(42);
+    });
+
+    EXPECT_NO_THROW(cancelled.get_future().get());
+}
+
+TYPED_TEST(FutureTest, shouldCallCancelHandlerImmediatelyWhenAlreadyCancelled)
+{
+    std::promise<void> cancelled;
+
+    this->executor_->post([&cancelled]() {
+        auto lazy = make_lazy_future<void>();
+        std::get<0>(lazy).cancel();
+        std::get<1>(lazy).on_cancel([&cancelled]() { cancelled.set_value(); });
+    });
+
+    EXPECT_NO_THROW(cancelled.get_future().get());
+}
+
+TYPED_TEST(FutureTest, shouldNotCallCancelHandlerAfterResolve)
+{
+    std::promise<void> done;
+
+    this->executor_->post([&done]() {
+        auto lazy = make_lazy_future<int>();
+        auto future = std::get<0>(lazy);
+        auto promise = std::get<1>(lazy);
+        promise.on_cancel([]() { ADD_FAILURE(); });
+
+        promise.set_value(42);
+        future.cancel();
+        future.then([&done](int value) {
+            EXPECT_EQ(42, value);
+            done.set_value();
+        });
+    });
+
+    EXPECT_NO_THROW(done.get_future().get());
+}
+
+TYPED_TEST(FutureTest, shouldSkipPendingContinuationOfCancelledFuture)
+{
+    std::promise<void> rejected;
+
+    this->executor_->post([&rejected]() {
+        // the continuation is posted right away, but can only run after this task has finished
+        auto continued = make_ready_future(42).then([](int) { ADD_FAILURE(); });
+        continued.cancel();
+        continued.catch_error([&rejected](auto e) { rejected.set_exception(e); });
+    });
+
+    EXPECT_THROW(rejected.get_future().get(), Cancelled);
+}
+
+TYPED_TEST(FutureTest, shouldCancelFutureReturnedByContinuation)
+{
+    std::promise<Promise<void>> innerPromise;
+    std::promise<void> cancelled;
+    auto innerPromiseFuture = innerPromise.get_future();
+
+    std::optional<Future<void>> outer;
+    this->executor_->post([&innerPromise, &cancelled, &outer]() {
+        outer.emplace(make_ready_future().then([&innerPromise, &cancelled]() {
+            auto lazy = make_lazy_future<void>();
+            std::get<1>(lazy).on_cancel([&cancelled]() { cancelled.set_value(); });
+            innerPromise.set_value(std::get<1>(lazy));
+            return std::get<0>(lazy);
+        }));
+    });
+
+    innerPromiseFuture.wait();
+    this->executor_->post([&outer]() { outer->cancel(); });
+
+    EXPECT_NO_THROW(cancelled.get_future().get());
+}
+
+TYPED_TEST(FutureTest, shouldNotRunAsyncFunctionWhenCancelled)
+{
+    std::promise<void> rejected;
+
+    this->executor_->post([this, &rejected]() {
+        auto future = async(this->executor_, []() { ADD_FAILURE(); });
+        future.cancel();
+        future.catch_error([&rejected](auto e) { rejected.set_exception(e); });
+    });
+
+    EXPECT_THROW(rejected.get_future().get(), Cancelled);
+}
+
 /// FutureThrowingExecutorTest provides test cases that ensure futures behave correctly in case
 /// underlying executors encounter runtime errors that prevent them to execute tasks that futures
 /// schedule on them.
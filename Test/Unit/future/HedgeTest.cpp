@@ -0,0 +1,180 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "asyncly/future/Hedge.h"
+
+#include "asyncly/test/FakeFutureTest.h"
+
+#include "gmock/gmock.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+namespace asyncly {
+
+using namespace testing;
+
+class HedgeTest : public test::FakeFutureTest {
+  public:
+    // every attempt returns a future that the test settles through promises_
+    auto attempt()
+    {
+        return [this]() {
+            auto lazy = make_lazy_future<int>();
+            promises_.push_back(std::get<1>(lazy));
+            return std::get<0>(lazy);
+        };
+    }
+
+  protected:
+    std::vector<Promise<int>> promises_;
+};
+
+TEST_F(HedgeTest, shouldNotHedgeFastAttempts)
+{
+    auto future = hedge(std::chrono::milliseconds(10), 3, attempt());
+    promises_.at(0).set_value(1);
+
+    EXPECT_EQ(1, wait_for_future(std::move(future)));
+    get_fake_executor()->advanceClock(std::chrono::seconds(1));
+    EXPECT_EQ(1u, promises_.size());
+}
+
+TEST_F(HedgeTest, shouldResolveWithFirstSuccessAndCancelOthers)
+{
+    //! [Hedge]
+    auto future = hedge(std::chrono::milliseconds(10), 3, attempt());
+    //! [Hedge]
+
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(9));
+    EXPECT_EQ(1u, promises_.size());
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(1));
+    EXPECT_EQ(2u, promises_.size());
+
+    promises_.at(1).set_value(2);
+
+    EXPECT_EQ(2, wait_for_future(std::move(future)));
+    EXPECT_TRUE(promises_.at(0).is_cancelled());
+    get_fake_executor()->advanceClock(std::chrono::seconds(1));
+    EXPECT_EQ(2u, promises_.size());
+}
+
+TEST_F(HedgeTest, shouldLimitNumberOfAttempts)
+{
+    auto future = hedge(std::chrono::milliseconds(10), 3, attempt());
+
+    get_fake_executor()->advanceClock(std::chrono::seconds(1));
+    EXPECT_EQ(3u, promises_.size());
+
+    promises_.at(0).set_value(1);
+    EXPECT_EQ(1, wait_for_future(std::move(future)));
+    EXPECT_TRUE(promises_.at(1).is_cancelled());
+    EXPECT_TRUE(promises_.at(2).is_cancelled());
+}
+
+TEST_F(HedgeTest, shouldStartNextAttemptRightAwayAfterFailure)
+{
+    auto future = hedge(std::chrono::seconds(10), 3, attempt());
+
+    promises_.at(0).set_exception(std::runtime_error{ "failed" });
+    get_fake_executor()->runTasks();
+    EXPECT_EQ(2u, promises_.size());
+
+    promises_.at(1).set_value(2);
+    EXPECT_EQ(2, wait_for_future(std::move(future)));
+}
+
+TEST_F(HedgeTest, shouldRejectWhenAllAttemptsFail)
+{
+    auto future = hedge(std::chrono::milliseconds(10), 2, attempt());
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(10));
+
+    promises_.at(1).set_exception(std::runtime_error{ "first" });
+    get_fake_executor()->runTasks();
+    promises_.at(0).set_exception(std::logic_error{ "last" });
+
+    EXPECT_THROW(wait_for_future(std::move(future)), std::logic_error);
+}
+
+TEST_F(HedgeTest, shouldCancelAttemptsWhenCancelled)
+{
+    auto future = hedge(std::chrono::milliseconds(10), 3, attempt());
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(10));
+
+    future.cancel();
+    get_fake_executor()->advanceClock(std::chrono::seconds(1));
+
+    EXPECT_EQ(2u, promises_.size());
+    EXPECT_TRUE(promises_.at(0).is_cancelled());
+    EXPECT_TRUE(promises_.at(1).is_cancelled());
+}
+
+TEST_F(HedgeTest, shouldHedgeVoidFunctions)
+{
+    auto calls = 0;
+    auto future = hedge(std::chrono::milliseconds(10), 2, [&calls]() {
+        calls++;
+        return make_ready_future();
+    });
+
+    EXPECT_NO_THROW(wait_for_future(std::move(future)));
+    EXPECT_EQ(1, calls);
+}
+
+TEST_F(HedgeTest, shouldUseDelayOfLatencyTracker)
+{
+    //! [Hedge Adaptive]
+    auto tracker = std::make_shared<HedgeLatencyTracker>(0.9, std::chrono::milliseconds(50));
+    auto future = hedge(tracker, 2, attempt());
+    //! [Hedge Adaptive]
+
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(20));
+    promises_.at(0).set_value(1);
+    EXPECT_EQ(1, wait_for_future(std::move(future)));
+    EXPECT_EQ(1u, promises_.size());
+
+    for (auto i = 0; i < 16; i++) {
+        tracker->record(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(std::chrono::milliseconds(5), tracker->delay());
+
+    auto hedged = hedge(tracker, 2, attempt());
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(5));
+    EXPECT_EQ(3u, promises_.size());
+    promises_.at(2).set_value(3);
+    EXPECT_EQ(3, wait_for_future(std::move(hedged)));
+}
+
+TEST(HedgeLatencyTrackerTest, shouldFollowPercentileOfRecentLatencies)
+{
+    HedgeLatencyTracker tracker{ 0.9, std::chrono::milliseconds(100), 32, 16 };
+    EXPECT_EQ(std::chrono::milliseconds(100), tracker.delay());
+
+    for (auto i = 1; i <= 32; i++) {
+        tracker.record(std::chrono::milliseconds(i));
+    }
+    EXPECT_EQ(std::chrono::milliseconds(29), tracker.delay());
+
+    for (auto i = 0; i < 32; i++) {
+        tracker.record(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(std::chrono::milliseconds(1), tracker.delay());
+}
+
+} // namespace asyncly
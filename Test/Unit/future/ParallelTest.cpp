@@ -0,0 +1,230 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "asyncly/future/Parallel.h"
+
+#include "StrandImplTestFactory.h"
+#include "asyncly/executor/ExecutorStoppedException.h"
+#include "asyncly/future/BlockingWait.h"
+#include "asyncly/test/ExecutorTestFactories.h"
+
+#include "gmock/gmock.h"
+
+#include <atomic>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace asyncly {
+
+using namespace testing;
+
+template <typename TExecutorFactory> class ParallelTest : public Test {
+  public:
+    ParallelTest()
+        : factory_(std::make_unique<TExecutorFactory>())
+        , executor_(factory_->create())
+    {
+    }
+
+    std::unique_ptr<TExecutorFactory> factory_;
+    std::shared_ptr<IExecutor> executor_;
+};
+
+using ExecutorFactoryTypes = ::testing::Types<
+    asyncly::test::AsioExecutorFactory<>,
+    asyncly::test::DefaultExecutorFactory<>,
+    asyncly::test::StrandImplTestFactory<>>;
+
+TYPED_TEST_SUITE(ParallelTest, ExecutorFactoryTypes);
+
+TYPED_TEST(ParallelTest, shouldVisitEveryElementExactlyOnce)
+{
+    std::vector<std::atomic<int>> visits(1000);
+
+    blocking_wait(parallel_for(
+        this->executor_, visits, [](std::atomic<int>& visit) { visit++; }, { 3, 7 }));
+
+    for (const auto& visit : visits) {
+        EXPECT_EQ(1, visit.load());
+    }
+}
+
+TYPED_TEST(ParallelTest, shouldResolveEmptyRangeImmediately)
+{
+    std::vector<int> empty;
+
+    EXPECT_NO_THROW(blocking_wait(parallel_for(this->executor_, empty, [](int) { FAIL(); })));
+    EXPECT_TRUE(blocking_wait(parallel_transform(this->executor_, empty, [](int i) { return i; }))
+                    .empty());
+    EXPECT_EQ(42, blocking_wait(parallel_reduce(this->executor_, empty, 42, std::plus<>{})));
+}
+
+TYPED_TEST(ParallelTest, shouldSupportIndexRanges)
+{
+    std::vector<int> squares(100);
+
+    blocking_wait(parallel_for(this->executor_, std::views::iota(0, 100), [&squares](int i) {
+        squares[static_cast<std::size_t>(i)] = i * i;
+    }));
+
+    for (auto i = 0; i < 100; i++) {
+        EXPECT_EQ(i * i, squares[static_cast<std::size_t>(i)]);
+    }
+}
+
+TYPED_TEST(ParallelTest, shouldTransformAndReduce)
+{
+    //! [Parallel Transform Reduce]
+    std::vector<int> input(10000);
+    std::iota(input.begin(), input.end(), 0);
+
+    auto squares = blocking_wait(parallel_transform(
+        this->executor_, input, [](int value) { return static_cast<long long>(value) * value; }));
+    auto sum = blocking_wait(parallel_reduce(this->executor_, squares, 0LL, std::plus<>{}));
+    //! [Parallel Transform Reduce]
+
+    ASSERT_EQ(input.size(), squares.size());
+    for (std::size_t i = 0; i < input.size(); i++) {
+        EXPECT_EQ(static_cast<long long>(input[i]) * input[i], squares[i]);
+    }
+    EXPECT_EQ(std::accumulate(squares.begin(), squares.end(), 0LL), sum);
+}
+
+TYPED_TEST(ParallelTest, shouldTransformToNonDefaultConstructibleResults)
+{
+    struct Wrapped {
+        explicit Wrapped(int v)
+            : value{ v }
+        {
+        }
+        int value;
+    };
+    std::vector<int> input{ 1, 2, 3, 4, 5 };
+
+    auto results = blocking_wait(parallel_transform(
+        this->executor_, input, [](int value) { return Wrapped{ value }; }, { 2, 1 }));
+
+    ASSERT_EQ(input.size(), results.size());
+    for (std::size_t i = 0; i < input.size(); i++) {
+        EXPECT_EQ(input[i], results[i].value);
+    }
+}
+
+TYPED_TEST(ParallelTest, shouldReduceInInputOrder)
+{
+    std::vector<std::string> input;
+    std::string expected = "init";
+    for (auto i = 0; i < 26; i++) {
+        input.push_back(std::string(1, static_cast<char>('a' + i)));
+        expected += input.back();
+    }
+
+    auto result = blocking_wait(parallel_reduce(
+        this->executor_, input, std::string{ "init" }, std::plus<>{}, { 4, 3 }));
+
+    EXPECT_EQ(expected, result);
+}
+
+TYPED_TEST(ParallelTest, shouldRejectWithExceptionOfElementFunction)
+{
+    std::vector<int> input(100);
+    std::iota(input.begin(), input.end(), 0);
+
+    EXPECT_THROW(
+        blocking_wait(parallel_for(
+            this->executor_,
+            input.begin(),
+            input.end(),
+            [](int value) {
+                if (value == 50) {
+                    throw std::runtime_error{ "failed" };
+                }
+            },
+            { 4, 8 })),
+        std::runtime_error);
+}
+
+namespace {
+// accepts a number of tasks without running them and throws like a stopped executor afterwards
+class StoppingExecutor : public IExecutor {
+  public:
+    explicit StoppingExecutor(std::size_t acceptedTasks)
+        : acceptedTasks_{ acceptedTasks }
+    {
+    }
+
+    void runTasks()
+    {
+        for (auto& task : tasks_) {
+            task();
+        }
+    }
+
+    clock_type::time_point now() const override
+    {
+        return clock_type::now();
+    }
+    void post(Task&& task) override
+    {
+        if (tasks_.size() == acceptedTasks_) {
+            throw ExecutorStoppedException{ "executor stopped" };
+        }
+        tasks_.push_back(std::move(task));
+    }
+    std::shared_ptr<Cancelable> post_at(const clock_type::time_point&, Task&&) override
+    {
+        throw ExecutorStoppedException{ "executor stopped" };
+    }
+    std::shared_ptr<Cancelable> post_after(const clock_type::duration&, Task&&) override
+    {
+        throw ExecutorStoppedException{ "executor stopped" };
+    }
+    [[nodiscard]] std::shared_ptr<AutoCancelable>
+    post_periodically(const clock_type::duration&, RepeatableTask&&) override
+    {
+        throw ExecutorStoppedException{ "executor stopped" };
+    }
+    ISchedulerPtr get_scheduler() const override
+    {
+        return {};
+    }
+
+  private:
+    const std::size_t acceptedTasks_;
+    std::vector<Task> tasks_;
+};
+} // namespace
+
+TEST(ParallelDispatchTest, shouldRejectWithoutProcessingWhenPostThrowsDuringDispatch)
+{
+    auto executor = std::make_shared<StoppingExecutor>(2);
+    std::vector<int> input(100);
+    std::atomic<int> visited{ 0 };
+
+    auto future = parallel_for(
+        executor, input.begin(), input.end(), [&visited](int) { visited++; }, { 4, 8 });
+    executor->runTasks();
+
+    EXPECT_THROW(blocking_wait(std::move(future)), ExecutorStoppedException);
+    EXPECT_EQ(0, visited.load());
+}
+
+} // namespace asyncly
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "asyncly/future/Retry.h"
+
+#include "asyncly/test/FakeFutureTest.h"
+
+#include "gmock/gmock.h"
+
+#include <chrono>
+#include <stdexcept>
+
+namespace asyncly {
+
+using namespace testing;
+
+namespace {
+struct NotRetryable : public std::runtime_error {
+    NotRetryable()
+        : std::runtime_error{ "not retryable" }
+    {
+    }
+};
+
+RetryPolicy fixedPolicy(std::size_t maxAttempts)
+{
+    RetryPolicy policy;
+    policy.maxAttempts = maxAttempts;
+    policy.initialDelay = std::chrono::milliseconds(100);
+    policy.multiplier = 2.0;
+    policy.jitter = 0.0;
+    return policy;
+}
+} // namespace
+
+class RetryTest : public test::FakeFutureTest {
+};
+
+TEST_F(RetryTest, shouldNotRetrySuccessfulAttempt)
+{
+    auto calls = 0;
+    auto future = retry(fixedPolicy(3), [&calls]() {
+        calls++;
+        return make_ready_future(42);
+    });
+
+    EXPECT_EQ(42, wait_for_future(std::move(future)));
+    EXPECT_EQ(1, calls);
+}
+
+TEST_F(RetryTest, shouldRetryWithExponentialBackoff)
+{
+    auto calls = 0;
+    //! [Retry]
+    auto policy = fixedPolicy(5);
+    policy.isRetryable = [](std::exception_ptr error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const NotRetryable&) {
+            return false;
+        } catch (...) {
+            return true;
+        }
+    };
+
+    auto future = retry(policy, [&calls]() {
+        if (++calls < 3) {
+            return make_exceptional_future<int>(std::runtime_error{ "temporary failure" });
+        }
+        return make_ready_future(calls);
+    });
+    //! [Retry]
+
+    get_fake_executor()->runTasks();
+    EXPECT_EQ(1, calls);
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(99));
+    EXPECT_EQ(1, calls);
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(1));
+    EXPECT_EQ(2, calls);
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(199));
+    EXPECT_EQ(2, calls);
+    get_fake_executor()->advanceClock(std::chrono::milliseconds(1));
+    EXPECT_EQ(3, calls);
+
+    EXPECT_EQ(3, wait_for_future(std::move(future)));
+}
+
+TEST_F(RetryTest, shouldRejectWithLastErrorAfterMaxAttempts)
+{
+    auto calls = 0;
+    auto future = retry(fixedPolicy(3), [&calls]() {
+        calls++;
+        return make_exceptional_future<void>(std::runtime_error{ std::to_string(calls) });
+    });
+
+    get_fake_executor()->advanceClock(std::chrono::seconds(1));
+
+    try {
+        wait_for_future(std::move(future));
+        FAIL();
+    } catch (const std::runtime_error& error) {
+        EXPECT_STREQ("3", error.what());
+    }
+    EXPECT_EQ(3, calls);
+}
+
+TEST_F(RetryTest, shouldNotRetryErrorsThatAreNotRetryable)
+{
+    auto calls = 0;
+    auto policy = fixedPolicy(3);
+    policy.isRetryable = [](std::exception_ptr) { return false; };
+
+    auto future = retry(policy, [&calls]() {
+        calls++;
+        return make_exceptional_future<int>(NotRetryable{});
+    });
+
+    get_fake_executor()->advanceClock(std::chrono::seconds(1));
+
+    EXPECT_THROW(wait_for_future(std::move(future)), NotRetryable);
+    EXPECT_EQ(1, calls);
+}
+
+TEST_F(RetryTest, shouldRetryExceptionsThrownByFunction)
+{
+    auto calls = 0;
+    auto future = retry(fixedPolicy(2), [&calls]() {
+        if (++calls == 1) {
+            throw std::runtime_error{ "thrown" };
+        }
+        return make_ready_future();
+    });
+
+    get_fake_executor()->advanceClock(std::chrono::seconds(1));
+
+    EXPECT_NO_THROW(wait_for_future(std::move(future)));
+    EXPECT_EQ(2, calls);
+}
+
+TEST_F(RetryTest, shouldStopRetryingWhenCancelled)
+{
+    auto calls = 0;
+    auto future = retry(fixedPolicy(3), [&calls]() {
+        calls++;
+        return make_exceptional_future<void>(std::runtime_error{ "failure" });
+    });
+    get_fake_executor()->runTasks();
+    EXPECT_EQ(1u, get_fake_executor()->queuedSchedulerTasks());
+
+    future.cancel();
+    get_fake_executor()->advanceClock(std::chrono::seconds(1));
+
+    EXPECT_THROW(wait_for_future(std::move(future)), Cancelled);
+    EXPECT_EQ(1, calls);
+}
+
+TEST(RetryDelayTest, shouldKeepJitteredDelaysWithinBounds)
+{
+    RetryPolicy policy;
+    policy.initialDelay = std::chrono::milliseconds(100);
+    policy.maxDelay = std::chrono::milliseconds(1000);
+    policy.multiplier = 2.0;
+    policy.jitter = 0.5;
+
+    for (auto i = 0; i < 100; i++) {
+        auto delay = detail::retry_delay(policy, 2);
+        EXPECT_GE(delay, std::chrono::milliseconds(100));
+        EXPECT_LE(delay, std::chrono::milliseconds(200));
+    }
+    EXPECT_LE(detail::retry_delay(policy, 20), std::chrono::milliseconds(1000));
+    EXPECT_GE(detail::retry_delay(policy, 20), std::chrono::milliseconds(500));
+}
+
+} // namespace asyncly
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "asyncly/future/SharedFuture.h"
+
+#include "StrandImplTestFactory.h"
+#include "asyncly/test/ExecutorTestFactories.h"
+
+#include "gmock/gmock.h"
+
+#include <future>
+#include <string>
+
+namespace asyncly {
+
+using namespace testing;
+
+template <typename TExecutorFactory> class SharedFutureTest : public Test {
+  public:
+    SharedFutureTest()
+        : factory_(std::make_unique<TExecutorFactory>())
+        , executor_(factory_->create())
+    {
+    }
+
+    std::unique_ptr<TExecutorFactory> factory_;
+    std::shared_ptr<IExecutor> executor_;
+};
+
+using ExecutorFactoryTypes = ::testing::Types<
+    asyncly::test::AsioExecutorFactory<>,
+    asyncly::test::DefaultExecutorFactory<>,
+    asyncly::test::StrandImplTestFactory<>>;
+
+TYPED_TEST_SUITE(SharedFutureTest, ExecutorFactoryTypes);
+
+TYPED_TEST(SharedFutureTest, shouldResolveConsumersBeforeAndAfterResolution)
+{
+    std::promise<std::string> first;
+    std::promise<std::string> second;
+    std::promise<std::string> third;
+
+    this->executor_->post([&first, &second, &third]() {
+        //! [SharedFuture Consumers]
+        auto lazy = make_lazy_future<std::string>();
+        auto shared = SharedFuture<std::string>{ std::get<0>(std::move(lazy)) };
+
+        shared.get_future().then([&first](std::string value) { first.set_value(value); });
+        shared.then([&second](const std::string& value) { second.set_value(value); });
+
+        std::get<1>(lazy).set_value("shared");
+        //! [SharedFuture Consumers]
+
+        shared.get_future().then([&third](std::string value) { third.set_value(value); });
+    });
+
+    EXPECT_EQ("shared", first.get_future().get());
+    EXPECT_EQ("shared", second.get_future().get());
+    EXPECT_EQ("shared", third.get_future().get());
+}
+
+TYPED_TEST(SharedFutureTest, shouldHandOutTheSameValueToAllConsumers)
+{
+    using SharedValue = std::shared_ptr<const std::unique_ptr<int>>;
+    std::promise<SharedValue> first;
+    std::promise<SharedValue> second;
+
+    this->executor_->post([&first, &second]() {
+        auto lazy = make_lazy_future<std::unique_ptr<int>>();
+        auto shared = SharedFuture<std::unique_ptr<int>>{ std::get<0>(std::move(lazy)) };
+
+        shared.get_shared().then([&first](SharedValue value) { first.set_value(value); });
+        std::get<1>(lazy).set_value(std::make_unique<int>(42));
+        shared.get_shared().then([&second](SharedValue value) { second.set_value(value); });
+    });
+
+    auto firstValue = first.get_future().get();
+    EXPECT_EQ(firstValue, second.get_future().get());
+    EXPECT_EQ(42, **firstValue);
+}
+
+TYPED_TEST(SharedFutureTest, shouldRejectAllConsumers)
+{
+    struct CustomError : public std::exception { };
+
+    std::promise<void> first;
+    std::promise<void> second;
+
+    this->executor_->post([&first, &second]() {
+        auto lazy = make_lazy_future<int>();
+        auto shared = SharedFuture<int>{ std::get<0>(std::move(lazy)) };
+
+        shared.get_future()
+            .then([](int) { ADD_FAILURE(); })
+            .catch_error([&first](auto e) { first.set_exception(e); });
+        std::get<1>(lazy).set_exception(CustomError{});
+        shared.get_shared()
+            .then([](auto) { ADD_FAILURE(); })
+            .catch_error([&second](auto e) { second.set_exception(e); });
+    });
+
+    EXPECT_THROW(first.get_future().get(), CustomError);
+    EXPECT_THROW(second.get_future().get(), CustomError);
+}
+
+TYPED_TEST(SharedFutureTest, shouldShareVoidFutures)
+{
+    std::promise<void> first;
+    std::promise<void> second;
+
+    this->executor_->post([&first, &second]() {
+        auto lazy = make_lazy_future<void>();
+        auto shared = SharedFuture<void>{ std::get<0>(std::move(lazy)) };
+
+        shared.get_future().then([&first]() { first.set_value(); });
+        std::get<1>(lazy).set_value();
+        shared.get_future().then([&second]() { second.set_value(); });
+    });
+
+    EXPECT_NO_THROW(first.get_future().get());
+    EXPECT_NO_THROW(second.get_future().get());
+}
+} // namespace asyncly
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "asyncly/future/TaskGraph.h"
+
+#include "StrandImplTestFactory.h"
+#include "asyncly/future/BlockingWait.h"
+#include "asyncly/test/ExecutorTestFactories.h"
+
+#include "gmock/gmock.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace asyncly {
+
+using namespace testing;
+
+static_assert(!std::is_copy_constructible_v<TaskGraph>, "copies would share the nodes");
+static_assert(std::is_nothrow_move_constructible_v<TaskGraph>);
+
+template <typename TExecutorFactory> class TaskGraphTest : public Test {
+  public:
+    TaskGraphTest()
+        : factory_(std::make_unique<TExecutorFactory>())
+        , executor_(factory_->create())
+    {
+    }
+
+    std::unique_ptr<TExecutorFactory> factory_;
+    std::shared_ptr<IExecutor> executor_;
+};
+
+using ExecutorFactoryTypes = ::testing::Types<
+    asyncly::test::AsioExecutorFactory<>,
+    asyncly::test::DefaultExecutorFactory<>,
+    asyncly::test::StrandImplTestFactory<>>;
+
+TYPED_TEST_SUITE(TaskGraphTest, ExecutorFactoryTypes);
+
+TYPED_TEST(TaskGraphTest, shouldRunTasksAfterTheirDependencies)
+{
+    std::mutex mutex;
+    std::vector<char> order;
+    auto record = [&mutex, &order](char name) {
+        return [&mutex, &order, name]() {
+            std::lock_guard<std::mutex> lock{ mutex };
+            order.push_back(name);
+        };
+    };
+
+    //! [TaskGraph Diamond]
+    TaskGraph graph;
+    auto load = graph.add_task(record('a'));
+    auto left = graph.add_task(record('b'));
+    auto right = graph.add_task(record('c'));
+    auto merge = graph.add_task(record('d'));
+    graph.add_dependency(load, left);
+    graph.add_dependency(load, right);
+    graph.add_dependency(left, merge);
+    graph.add_dependency(right, merge);
+
+    blocking_wait(graph.run(this->executor_));
+    //! [TaskGraph Diamond]
+
+    ASSERT_EQ(4u, order.size());
+    EXPECT_EQ('a', order.front());
+    EXPECT_EQ('d', order.back());
+    EXPECT_THAT(order, UnorderedElementsAre('a', 'b', 'c', 'd'));
+}
+
+TYPED_TEST(TaskGraphTest, shouldBeReusable)
+{
+    std::atomic<int> calls{ 0 };
+    TaskGraph graph;
+    auto first = graph.add_task([&calls]() { calls++; });
+    auto second = graph.add_task([&calls]() { calls++; });
+    graph.add_dependency(first, second);
+
+    for (auto run = 0; run < 10; run++) {
+        blocking_wait(graph.run(this->executor_));
+    }
+
+    EXPECT_EQ(20, calls.load());
+}
+
+TYPED_TEST(TaskGraphTest, shouldRunWideGraph)
+{
+    const auto width = 100;
+    std::atomic<int> started{ 0 };
+    auto finishedBeforeSink = -1;
+
+    TaskGraph graph;
+    auto source = graph.add_task([]() {});
+    auto sink = graph.add_task([&started, &finishedBeforeSink]() {
+        finishedBeforeSink = started.load();
+    });
+    for (auto i = 0; i < width; i++) {
+        auto node = graph.add_task([&started]() { started++; });
+        graph.add_dependency(source, node);
+        graph.add_dependency(node, sink);
+    }
+
+    blocking_wait(graph.run(this->executor_));
+
+    EXPECT_EQ(width, finishedBeforeSink);
+}
+
+TYPED_TEST(TaskGraphTest, shouldResolveEmptyGraph)
+{
+    TaskGraph graph;
+
+    EXPECT_NO_THROW(blocking_wait(graph.run(this->executor_)));
+}
+
+TYPED_TEST(TaskGraphTest, shouldWaitForAsynchronousTasks)
+{
+    auto executor = this->executor_;
+    std::atomic<bool> asyncDone{ false };
+    auto sawAsyncDone = false;
+
+    TaskGraph graph;
+    auto async = graph.add_task([executor, &asyncDone]() {
+        auto lazy = make_lazy_future<void>();
+        executor->post_after(
+            std::chrono::milliseconds(5), [&asyncDone, promise = std::get<1>(lazy)]() mutable {
+                asyncDone = true;
+                promise.set_value();
+            });
+        return std::get<0>(lazy);
+    });
+    auto after
+        = graph.add_task([&asyncDone, &sawAsyncDone]() { sawAsyncDone = asyncDone.load(); });
+    graph.add_dependency(async, after);
+
+    blocking_wait(graph.run(this->executor_));
+
+    EXPECT_TRUE(sawAsyncDone);
+}
+
+TYPED_TEST(TaskGraphTest, shouldNotChangeRunInProgressWhenModified)
+{
+    std::optional<Promise<void>> pending;
+    std::promise<void> started;
+    std::atomic<int> runs{ 0 };
+    std::atomic<int> added{ 0 };
+
+    TaskGraph graph;
+    auto first = graph.add_task([&pending, &started, &runs]() -> Future<void> {
+        if (runs++ > 0) {
+            return make_ready_future();
+        }
+        auto lazy = make_lazy_future<void>();
+        pending.emplace(std::get<1>(lazy));
+        started.set_value();
+        return std::get<0>(lazy);
+    });
+
+    auto running = graph.run(this->executor_);
+    started.get_future().get();
+    for (auto i = 0; i < 100; i++) {
+        graph.add_dependency(first, graph.add_task([&added]() { added++; }));
+    }
+    pending->set_value();
+
+    blocking_wait(std::move(running));
+    EXPECT_EQ(0, added.load());
+
+    blocking_wait(graph.run(this->executor_));
+    EXPECT_EQ(100, added.load());
+}
+
+TYPED_TEST(TaskGraphTest, shouldSkipDependentsOfFailedTask)
+{
+    auto dependentCalled = false;
+    TaskGraph graph;
+    auto failing = graph.add_task([]() { throw std::runtime_error{ "failed" }; });
+    auto dependent = graph.add_task([&dependentCalled]() { dependentCalled = true; });
+    graph.add_dependency(failing, dependent);
+
+    EXPECT_THROW(blocking_wait(graph.run(this->executor_)), std::runtime_error);
+    EXPECT_FALSE(dependentCalled);
+}
+
+TYPED_TEST(TaskGraphTest, shouldRejectCycles)
+{
+    auto called = false;
+    TaskGraph graph;
+    auto root = graph.add_task([&called]() { called = true; });
+    auto first = graph.add_task([&called]() { called = true; });
+    auto second = graph.add_task([&called]() { called = true; });
+    graph.add_dependency(root, first);
+    graph.add_dependency(first, second);
+    graph.add_dependency(second, first);
+
+    EXPECT_THROW(blocking_wait(graph.run(this->executor_)), std::invalid_argument);
+    EXPECT_FALSE(called);
+}
+
+TEST(TaskGraphValidationTest, shouldThrowOnInvalidDependencies)
+{
+    TaskGraph graph;
+    auto node = graph.add_task([]() {});
+
+    EXPECT_THROW(graph.add_dependency(node, node), std::invalid_argument);
+    EXPECT_THROW(graph.add_dependency(node, node + 1), std::invalid_argument);
+}
+
+} // namespace asyncly
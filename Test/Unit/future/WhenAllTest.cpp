@@ -25,6 +25,8 @@
 
 #include "gmock/gmock.h"
 
+#include <numeric>
+#include <thread>
 #include <tuple>
 
 namespace asyncly {
@@ -411,4 +413,112 @@ TYPED_TEST(WhenAllTest, shouldRejectContainerOfVoidFuturesWithMultipleErrors)
     });
     EXPECT_THROW(resultsFuture.get(), CustomError);
 }
+
+TYPED_TEST(WhenAllTest, shouldResolveVectorOfFuturesInInputOrder)
+{
+    std::promise<std::vector<int>> results;
+    auto resultsFuture = results.get_future();
+
+    this->executor_->post([&results]() {
+        std::vector<Future<int>> futures;
+        std::vector<Promise<int>> promises;
+        for (auto i = 0; i < 10; i++) {
+            auto lazy = make_lazy_future<int>();
+            futures.push_back(std::get<0>(lazy));
+            promises.push_back(std::get<1>(lazy));
+        }
+
+        when_all(std::move(futures)).then([&results](std::vector<int> values) {
+            results.set_value(std::move(values));
+        });
+
+        for (auto i = 9; i >= 0; i--) {
+            promises[i].set_value(i);
+        }
+    });
+    EXPECT_THAT(
+        resultsFuture.get(), ContainerEq(std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+}
+
+TYPED_TEST(WhenAllTest, shouldResolveVectorOfMoveOnlyFutures)
+{
+    std::promise<std::vector<int>> results;
+    auto resultsFuture = results.get_future();
+
+    this->executor_->post([&results]() {
+        std::vector<Future<std::unique_ptr<int>>> futures;
+        futures.push_back(make_ready_future(std::make_unique<int>(1)));
+        futures.push_back(make_ready_future(std::make_unique<int>(2)));
+
+        when_all(std::move(futures)).then([&results](std::vector<std::unique_ptr<int>> values) {
+            std::vector<int> unwrapped;
+            for (const auto& value : values) {
+                unwrapped.push_back(*value);
+            }
+            results.set_value(unwrapped);
+        });
+    });
+    EXPECT_THAT(resultsFuture.get(), ContainerEq(std::vector<int>{ 1, 2 }));
+}
+
+TYPED_TEST(WhenAllTest, shouldResolveVectorOfFuturesResolvedFromOtherThreads)
+{
+    constexpr auto numberOfFutures = 1000;
+
+    std::vector<Promise<int>> promises;
+    std::promise<std::vector<int>> results;
+    auto resultsFuture = results.get_future();
+    std::promise<void> ready;
+
+    this->executor_->post([&promises, &results, &ready]() {
+        std::vector<Future<int>> futures;
+        for (auto i = 0; i < numberOfFutures; i++) {
+            auto lazy = make_lazy_future<int>();
+            futures.push_back(std::get<0>(lazy));
+            promises.push_back(std::get<1>(lazy));
+        }
+
+        when_all(std::move(futures)).then([&results](std::vector<int> values) {
+            results.set_value(std::move(values));
+        });
+        ready.set_value();
+    });
+    ready.get_future().wait();
+
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; t++) {
+        threads.emplace_back([&promises, t]() {
+            for (auto i = t; i < numberOfFutures; i += 4) {
+                promises[i].set_value(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<int> expected(numberOfFutures);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_THAT(resultsFuture.get(), ContainerEq(expected));
+}
+
+TYPED_TEST(WhenAllTest, shouldRejectVectorOfFutures)
+{
+    struct CustomError : public std::exception { };
+
+    std::promise<void> results;
+    auto resultsFuture = results.get_future();
+
+    this->executor_->post([&results]() {
+        std::vector<Future<int>> futures;
+        futures.push_back(make_ready_future<int>(3));
+        futures.push_back(make_exceptional_future<int>(CustomError{}));
+        futures.push_back(make_exceptional_future<int>(CustomError{}));
+
+        when_all(std::move(futures))
+            .then([](auto) mutable { FAIL(); })
+            .catch_error([&results](auto e) { results.set_exception(e); });
+    });
+    EXPECT_THROW(resultsFuture.get(), CustomError);
+}
 } // namespace asyncly
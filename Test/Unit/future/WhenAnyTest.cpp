@@ -24,6 +24,8 @@
 
 #include "gmock/gmock.h"
 
+#include <vector>
+
 namespace asyncly {
 
 using namespace testing;
@@ -257,4 +259,124 @@ TYPED_TEST(WhenAnyTest, shouldIgnoreResolveAfterRejectForWhenAny)
     EXPECT_NO_THROW(rejected.get_future().get());
     promise2.set_value(1);
 }
+
+TYPED_TEST(WhenAnyTest, shouldResolveRangeWithIndexOfFirstResolvedFuture)
+{
+    std::promise<IndexedValue<int>> resolved;
+
+    this->executor_->post([&resolved]() {
+        std::vector<Future<int>> futures;
+        std::vector<Promise<int>> promises;
+        for (auto i = 0; i < 3; i++) {
+            auto lazy = make_lazy_future<int>();
+            futures.push_back(std::get<0>(lazy));
+            promises.push_back(std::get<1>(lazy));
+        }
+
+        when_any(futures.begin(), futures.end()).then([&resolved](IndexedValue<int> result) {
+            resolved.set_value(result);
+        });
+        promises[1].set_value(42);
+        promises[0].set_value(23);
+    });
+
+    auto result = resolved.get_future().get();
+    EXPECT_EQ(1u, result.index);
+    EXPECT_EQ(42, result.value);
+}
+
+TYPED_TEST(WhenAnyTest, shouldResolveVectorOfVoidFutures)
+{
+    std::promise<std::size_t> resolved;
+
+    this->executor_->post([&resolved]() {
+        auto lazy = make_lazy_future<void>();
+        std::vector<Future<void>> futures;
+        futures.push_back(std::get<0>(lazy));
+        futures.push_back(make_ready_future());
+
+        when_any(std::move(futures)).then([&resolved](IndexedValue<void> result) {
+            resolved.set_value(result.index);
+        });
+    });
+
+    EXPECT_EQ(1u, resolved.get_future().get());
+}
+
+TYPED_TEST(WhenAnyTest, shouldCancelLosersOfRange)
+{
+    std::promise<void> firstCancelled;
+    std::promise<void> thirdCancelled;
+    std::vector<Promise<int>> promises;
+
+    this->executor_->post([&firstCancelled, &thirdCancelled, &promises]() {
+        auto lazy1 = make_lazy_future<int>();
+        auto lazy3 = make_lazy_future<int>();
+        promises.push_back(std::get<1>(lazy1));
+        promises.push_back(std::get<1>(lazy3));
+        promises[0].on_cancel([&firstCancelled]() { firstCancelled.set_value(); });
+        promises[1].on_cancel([&thirdCancelled]() { thirdCancelled.set_value(); });
+
+        std::vector<Future<int>> futures;
+        futures.push_back(std::get<0>(lazy1));
+        futures.push_back(make_ready_future(42));
+        futures.push_back(std::get<0>(lazy3).then([](int value) { return value; }));
+
+        when_any(std::move(futures));
+    });
+
+    EXPECT_NO_THROW(firstCancelled.get_future().get());
+    EXPECT_NO_THROW(thirdCancelled.get_future().get());
+}
+
+TYPED_TEST(WhenAnyTest, shouldCancelRangeWhenResultIsCancelled)
+{
+    std::promise<void> cancelled;
+    std::vector<Promise<int>> promises;
+
+    this->executor_->post([&cancelled, &promises]() {
+        auto lazy = make_lazy_future<int>();
+        promises.push_back(std::get<1>(lazy));
+        promises[0].on_cancel([&cancelled]() { cancelled.set_value(); });
+
+        std::vector<Future<int>> futures;
+        futures.push_back(std::get<0>(lazy));
+
+        when_any(std::move(futures)).cancel();
+    });
+
+    EXPECT_NO_THROW(cancelled.get_future().get());
+}
+
+TYPED_TEST(WhenAnyTest, shouldRejectRangeOnFirstError)
+{
+    struct CustomError : public std::exception { };
+
+    std::promise<void> rejected;
+
+    this->executor_->post([&rejected]() {
+        std::vector<Future<int>> futures;
+        futures.push_back(std::get<0>(make_lazy_future<int>()));
+        futures.push_back(make_exceptional_future<int>(CustomError{}));
+
+        when_any(std::move(futures))
+            .then([](auto) { ADD_FAILURE(); })
+            .catch_error([&rejected](auto e) { rejected.set_exception(e); });
+    });
+
+    EXPECT_THROW(rejected.get_future().get(), CustomError);
+}
+
+TYPED_TEST(WhenAnyTest, shouldRejectEmptyRange)
+{
+    std::promise<void> rejected;
+
+    this->executor_->post([&rejected]() {
+        when_any(std::vector<Future<int>>{})
+            .then([](auto) { ADD_FAILURE(); })
+            .catch_error([&rejected](auto e) { rejected.set_exception(e); });
+    });
+
+    EXPECT_THROW(rejected.get_future().get(), std::invalid_argument);
+}
 } // namespace asyncly
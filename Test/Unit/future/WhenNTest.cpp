@@ -0,0 +1,194 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "asyncly/future/WhenN.h"
+
+#include "StrandImplTestFactory.h"
+#include "asyncly/future/Future.h"
+#include "asyncly/test/ExecutorTestFactories.h"
+
+#include "gmock/gmock.h"
+
+#include <vector>
+
+namespace asyncly {
+
+using namespace testing;
+
+template <typename TExecutorFactory> class WhenNTest : public Test {
+  public:
+    WhenNTest()
+        : factory_(std::make_unique<TExecutorFactory>())
+        , executor_(factory_->create())
+    {
+    }
+
+    std::unique_ptr<TExecutorFactory> factory_;
+    std::shared_ptr<IExecutor> executor_;
+};
+
+using ExecutorFactoryTypes = ::testing::Types<
+    asyncly::test::AsioExecutorFactory<>,
+    asyncly::test::DefaultExecutorFactory<>,
+    asyncly::test::StrandImplTestFactory<>>;
+
+TYPED_TEST_SUITE(WhenNTest, ExecutorFactoryTypes);
+
+TYPED_TEST(WhenNTest, shouldResolveWithFirstKValuesInCompletionOrder)
+{
+    std::promise<std::vector<IndexedValue<int>>> resolved;
+    std::vector<Promise<int>> promises;
+
+    this->executor_->post([&resolved, &promises]() {
+        std::vector<Future<int>> futures;
+        for (auto i = 0; i < 4; i++) {
+            auto lazy = make_lazy_future<int>();
+            futures.push_back(std::get<0>(lazy));
+            promises.push_back(std::get<1>(lazy));
+        }
+
+        when_n(2, futures.begin(), futures.end())
+            .then([&resolved](std::vector<IndexedValue<int>> results) {
+                resolved.set_value(std::move(results));
+            });
+
+        promises[2].set_value(2);
+        promises[0].set_value(0);
+        promises[3].set_value(3);
+    });
+
+    auto results = resolved.get_future().get();
+    ASSERT_EQ(2u, results.size());
+    EXPECT_EQ(2u, results[0].index);
+    EXPECT_EQ(2, results[0].value);
+    EXPECT_EQ(0u, results[1].index);
+    EXPECT_EQ(0, results[1].value);
+}
+
+TYPED_TEST(WhenNTest, shouldTolerateFailuresAsLongAsKSuccessesArePossible)
+{
+    struct CustomError : public std::exception { };
+
+    std::promise<std::vector<std::size_t>> resolved;
+
+    this->executor_->post([&resolved]() {
+        std::vector<Future<void>> futures;
+        futures.push_back(make_exceptional_future<void>(CustomError{}));
+        futures.push_back(make_ready_future());
+        futures.push_back(make_exceptional_future<void>(CustomError{}));
+        futures.push_back(make_ready_future());
+
+        when_n(2, std::move(futures)).then([&resolved](std::vector<IndexedValue<void>> results) {
+            std::vector<std::size_t> indices;
+            for (const auto& result : results) {
+                indices.push_back(result.index);
+            }
+            resolved.set_value(indices);
+        });
+    });
+
+    EXPECT_THAT(resolved.get_future().get(), UnorderedElementsAre(1u, 3u));
+}
+
+TYPED_TEST(WhenNTest, shouldRejectOnceKSuccessesAreImpossible)
+{
+    struct CustomError : public std::exception { };
+
+    std::promise<void> rejected;
+    std::vector<Promise<int>> promises;
+
+    this->executor_->post([&rejected, &promises]() {
+        auto lazy = make_lazy_future<int>();
+        promises.push_back(std::get<1>(lazy));
+
+        std::vector<Future<int>> futures;
+        futures.push_back(make_exceptional_future<int>(CustomError{}));
+        futures.push_back(std::get<0>(lazy));
+        futures.push_back(make_exceptional_future<int>(CustomError{}));
+
+        when_n(2, std::move(futures))
+            .then([](auto) { ADD_FAILURE(); })
+            .catch_error([&rejected](auto e) { rejected.set_exception(e); });
+    });
+
+    EXPECT_THROW(rejected.get_future().get(), CustomError);
+}
+
+TYPED_TEST(WhenNTest, shouldCancelRemainingFutures)
+{
+    std::promise<void> cancelled;
+    std::vector<Promise<int>> promises;
+
+    this->executor_->post([&cancelled, &promises]() {
+        auto lazy = make_lazy_future<int>();
+        promises.push_back(std::get<1>(lazy));
+        promises[0].on_cancel([&cancelled]() { cancelled.set_value(); });
+
+        std::vector<Future<int>> futures;
+        futures.push_back(make_ready_future(1));
+        futures.push_back(std::get<0>(lazy));
+        futures.push_back(make_ready_future(3));
+
+        when_n(2, std::move(futures));
+    });
+
+    EXPECT_NO_THROW(cancelled.get_future().get());
+}
+
+TYPED_TEST(WhenNTest, shouldNotCancelRemainingFuturesWhenNotRequested)
+{
+    std::promise<bool> isCancelled;
+    std::vector<Promise<int>> promises;
+
+    this->executor_->post([&isCancelled, &promises]() {
+        auto lazy = make_lazy_future<int>();
+        promises.push_back(std::get<1>(lazy));
+
+        std::vector<Future<int>> futures;
+        futures.push_back(make_ready_future(1));
+        futures.push_back(std::get<0>(lazy));
+
+        when_n(1, std::move(futures), false).then([&isCancelled, &promises](auto) {
+            isCancelled.set_value(promises[0].is_cancelled());
+        });
+    });
+
+    EXPECT_FALSE(isCancelled.get_future().get());
+}
+
+TYPED_TEST(WhenNTest, shouldResolveImmediatelyForZeroAndRejectForTooLargeK)
+{
+    std::promise<std::size_t> resolved;
+    std::promise<void> rejected;
+
+    this->executor_->post([&resolved, &rejected]() {
+        std::vector<Future<int>> futures;
+        futures.push_back(make_ready_future(1));
+
+        when_n(0, futures.begin(), futures.end()).then([&resolved](auto results) {
+            resolved.set_value(results.size());
+        });
+        when_n(2, futures.begin(), futures.end())
+            .then([](auto) { ADD_FAILURE(); })
+            .catch_error([&rejected](auto e) { rejected.set_exception(e); });
+    });
+
+    EXPECT_EQ(0u, resolved.get_future().get());
+    EXPECT_THROW(rejected.get_future().get(), std::invalid_argument);
+}
+} // namespace asyncly
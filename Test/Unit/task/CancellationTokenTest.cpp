@@ -0,0 +1,306 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "asyncly/task/CancellationToken.h"
+
+#include "asyncly/executor/CancellationAwarePost.h"
+#include "asyncly/future/Future.h"
+#include "asyncly/future/WhenAll.h"
+#include "asyncly/future/WhenAny.h"
+
+#include "StrandImplTestFactory.h"
+#include "asyncly/test/ExecutorTestFactories.h"
+
+#include "gmock/gmock.h"
+
+#include <chrono>
+#include <future>
+#include <optional>
+
+namespace asyncly {
+
+using namespace testing;
+
+TEST(CancellationTokenTest, shouldNeverCancelDefaultConstructedToken)
+{
+    CancellationToken token;
+
+    auto called = false;
+    auto registration = token.on_cancel([&called]() { called = true; });
+
+    EXPECT_FALSE(token.can_be_cancelled());
+    EXPECT_FALSE(token.is_cancelled());
+    EXPECT_FALSE(called);
+}
+
+TEST(CancellationTokenTest, shouldCallCallbacksOnCancel)
+{
+    CancellationSource source;
+    auto token = source.get_token();
+
+    auto calls = 0;
+    auto first = token.on_cancel([&calls]() { calls++; });
+    auto second = token.on_cancel([&calls]() { calls++; });
+
+    EXPECT_TRUE(source.cancel());
+    EXPECT_FALSE(source.cancel());
+    EXPECT_TRUE(token.is_cancelled());
+    EXPECT_EQ(2, calls);
+}
+
+TEST(CancellationTokenTest, shouldCallCallbackImmediatelyWhenAlreadyCancelled)
+{
+    CancellationSource source;
+    source.cancel();
+
+    auto called = false;
+    auto registration = source.get_token().on_cancel([&called]() { called = true; });
+
+    EXPECT_TRUE(called);
+}
+
+TEST(CancellationTokenTest, shouldNotCallCallbackAfterRegistrationIsReset)
+{
+    CancellationSource source;
+
+    auto capture = std::make_shared<int>(0);
+    std::weak_ptr<int> weakCapture = capture;
+    auto called = false;
+    auto registration
+        = source.get_token().on_cancel([&called, capture = std::move(capture)]() { called = true; });
+    registration.reset();
+
+    EXPECT_TRUE(weakCapture.expired());
+    source.cancel();
+    EXPECT_FALSE(called);
+}
+
+TEST(CancellationTokenTest, shouldCancelLinkedSourceWithParent)
+{
+    CancellationSource parent;
+    CancellationSource child{ parent.get_token() };
+
+    parent.cancel();
+
+    EXPECT_TRUE(child.is_cancelled());
+}
+
+TEST(CancellationTokenTest, shouldNotCancelParentWithLinkedSource)
+{
+    CancellationSource parent;
+    CancellationSource child{ parent.get_token() };
+
+    child.cancel();
+
+    EXPECT_FALSE(parent.is_cancelled());
+}
+
+template <typename TExecutorFactory> class CancellationTokenFutureTest : public Test {
+  public:
+    CancellationTokenFutureTest()
+        : factory_(std::make_unique<TExecutorFactory>())
+        , executor_(factory_->create())
+    {
+    }
+
+    std::unique_ptr<TExecutorFactory> factory_;
+    std::shared_ptr<IExecutor> executor_;
+};
+
+using ExecutorFactoryTypes = ::testing::Types<
+    asyncly::test::AsioExecutorFactory<>,
+    asyncly::test::DefaultExecutorFactory<>,
+    asyncly::test::StrandImplTestFactory<>>;
+
+TYPED_TEST_SUITE(CancellationTokenFutureTest, ExecutorFactoryTypes);
+
+TYPED_TEST(CancellationTokenFutureTest, shouldSkipContinuationsWhenTokenIsCancelled)
+{
+    CancellationSource source;
+    std::optional<Promise<int>> producer;
+    std::promise<void> cancelled;
+
+    this->executor_->post([&source, &producer, &cancelled]() {
+        auto lazy = make_lazy_future<int>();
+        producer.emplace(std::get<1>(lazy));
+
+        std::get<0>(lazy)
+            .with_cancellation(source.get_token())
+            .then([](int value) { return value + 1; })
+            .then([](int) { ADD_FAILURE(); })
+            .catch_error([&cancelled](std::exception_ptr error) {
+                try {
+                    std::rethrow_exception(error);
+                } catch (const Cancelled&) {
+                    cancelled.set_value();
+                } catch (...) {
+                    ADD_FAILURE();
+                }
+            });
+
+        source.cancel();
+        producer->set_value(42);
+    });
+
+    EXPECT_NO_THROW(cancelled.get_future().get());
+    EXPECT_TRUE(producer->is_cancelled());
+}
+
+TYPED_TEST(CancellationTokenFutureTest, shouldCancelFutureWhenTokenIsAlreadyCancelled)
+{
+    CancellationSource source;
+    source.cancel();
+    std::optional<Promise<void>> producer;
+    std::promise<bool> cancelled;
+
+    this->executor_->post([&source, &producer, &cancelled]() {
+        auto lazy = make_lazy_future<void>();
+        producer.emplace(std::get<1>(lazy));
+        producer->on_cancel([&cancelled]() { cancelled.set_value(true); });
+
+        std::get<0>(lazy).with_cancellation(source.get_token()).then([]() { ADD_FAILURE(); });
+    });
+
+    EXPECT_TRUE(cancelled.get_future().get());
+}
+
+TYPED_TEST(CancellationTokenFutureTest, shouldCancelAllInputsOfWhenAll)
+{
+    CancellationSource source;
+    std::vector<Promise<void>> producers;
+    std::promise<void> firstCancelled;
+    std::promise<void> secondCancelled;
+    std::promise<void> allCancelled;
+
+    //! [CancellationToken FanOut]
+    this->executor_->post([&]() {
+        auto first = make_lazy_future<void>();
+        auto second = make_lazy_future<void>();
+        std::get<1>(first).on_cancel([&firstCancelled]() { firstCancelled.set_value(); });
+        std::get<1>(second).on_cancel([&secondCancelled]() { secondCancelled.set_value(); });
+        producers.push_back(std::get<1>(first));
+        producers.push_back(std::get<1>(second));
+
+        // the token is inherited by the continuation, cancelling it tears down the whole tree
+        when_all(std::get<0>(std::move(first)), std::get<0>(std::move(second)))
+            .with_cancellation(source.get_token())
+            .then([]() { ADD_FAILURE(); })
+            .catch_error([&allCancelled](std::exception_ptr) { allCancelled.set_value(); });
+
+        source.cancel();
+    });
+    //! [CancellationToken FanOut]
+
+    EXPECT_NO_THROW(firstCancelled.get_future().get());
+    EXPECT_NO_THROW(secondCancelled.get_future().get());
+    EXPECT_NO_THROW(allCancelled.get_future().get());
+}
+
+TYPED_TEST(CancellationTokenFutureTest, shouldCancelAllInputsOfRangeWhenAll)
+{
+    CancellationSource source;
+    std::vector<Promise<int>> producers;
+    std::promise<void> allCancelled;
+    auto cancelledInputs = std::make_shared<std::atomic<int>>(0);
+
+    this->executor_->post([&source, &producers, cancelledInputs]() {
+        std::vector<Future<int>> futures;
+        for (auto i = 0; i < 3; i++) {
+            auto lazy = make_lazy_future<int>();
+            std::get<1>(lazy).on_cancel([cancelledInputs]() { (*cancelledInputs)++; });
+            producers.push_back(std::get<1>(lazy));
+            futures.push_back(std::get<0>(lazy));
+        }
+
+        when_all(std::move(futures)).with_cancellation(source.get_token());
+        source.cancel();
+    });
+
+    this->executor_->post([&allCancelled]() { allCancelled.set_value(); });
+    allCancelled.get_future().get();
+    EXPECT_EQ(3, cancelledInputs->load());
+}
+
+TYPED_TEST(CancellationTokenFutureTest, shouldCancelAllInputsOfWhenAny)
+{
+    CancellationSource source;
+    std::optional<Promise<int>> firstProducer;
+    std::optional<Promise<void>> secondProducer;
+    std::promise<void> allCancelled;
+    auto cancelledInputs = std::make_shared<std::atomic<int>>(0);
+
+    this->executor_->post([&source, &firstProducer, &secondProducer, cancelledInputs]() {
+        auto first = make_lazy_future<int>();
+        auto second = make_lazy_future<void>();
+        std::get<1>(first).on_cancel([cancelledInputs]() { (*cancelledInputs)++; });
+        std::get<1>(second).on_cancel([cancelledInputs]() { (*cancelledInputs)++; });
+        firstProducer.emplace(std::get<1>(first));
+        secondProducer.emplace(std::get<1>(second));
+
+        when_any(std::get<0>(std::move(first)), std::get<0>(std::move(second)))
+            .with_cancellation(source.get_token());
+        source.cancel();
+    });
+
+    this->executor_->post([&allCancelled]() { allCancelled.set_value(); });
+    allCancelled.get_future().get();
+    EXPECT_EQ(2, cancelledInputs->load());
+}
+
+TYPED_TEST(CancellationTokenFutureTest, shouldReleaseTimerTaskOnCancel)
+{
+    CancellationSource source;
+    auto capture = std::make_shared<int>(0);
+    std::weak_ptr<int> weakCapture = capture;
+    std::promise<void> posted;
+
+    this->executor_->post([this, &source, &posted, capture = std::move(capture)]() mutable {
+        post_after(
+            this->executor_,
+            std::chrono::hours(1),
+            [capture = std::move(capture)]() { ADD_FAILURE(); },
+            source.get_token());
+        posted.set_value();
+    });
+    posted.get_future().get();
+
+    EXPECT_FALSE(weakCapture.expired());
+    source.cancel();
+    EXPECT_TRUE(weakCapture.expired());
+}
+
+TYPED_TEST(CancellationTokenFutureTest, shouldNotRunTimerTaskWhenTokenIsAlreadyCancelled)
+{
+    CancellationSource source;
+    source.cancel();
+    std::promise<void> done;
+
+    this->executor_->post([this, &source, &done]() {
+        post_after(
+            this->executor_,
+            std::chrono::milliseconds(0),
+            []() { ADD_FAILURE(); },
+            source.get_token());
+        this->executor_->post_after(
+            std::chrono::milliseconds(20), [&done]() { done.set_value(); });
+    });
+
+    EXPECT_NO_THROW(done.get_future().get());
+}
+
+} // namespace asyncly
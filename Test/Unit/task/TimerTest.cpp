@@ -0,0 +1,128 @@
+/*
+ * Copyright 2022 GoTo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "gmock/gmock.h"
+
+#include "asyncly/task/Timer.h"
+#include "asyncly/test/FakeExecutor.h"
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+namespace asyncly {
+
+using namespace testing;
+
+class TimerTest : public Test {
+  public:
+    TimerTest()
+        : executor_(test::FakeExecutor::create())
+        , timer_(Timer::create(executor_, [this]() { fired_++; }))
+    {
+    }
+
+  protected:
+    std::shared_ptr<test::FakeExecutor> executor_;
+    std::shared_ptr<Timer> timer_;
+    int fired_ = 0;
+};
+
+TEST_F(TimerTest, shouldFireAfterTimeout)
+{
+    timer_->reset(10ms);
+    EXPECT_TRUE(timer_->is_armed());
+
+    executor_->advanceClock(9ms);
+    EXPECT_EQ(0, fired_);
+    executor_->advanceClock(1ms);
+    EXPECT_EQ(1, fired_);
+    EXPECT_FALSE(timer_->is_armed());
+}
+
+TEST_F(TimerTest, shouldMoveDeadlineBackWithoutRescheduling)
+{
+    //! [Timer Idle Timeout]
+    // push the idle timeout back whenever there is activity
+    timer_->reset(10ms);
+    for (auto i = 0; i < 5; i++) {
+        executor_->advanceClock(5ms);
+        timer_->reset(10ms);
+    }
+    //! [Timer Idle Timeout]
+    EXPECT_EQ(1u, executor_->queuedSchedulerTasks());
+    EXPECT_EQ(0, fired_);
+
+    executor_->advanceClock(9ms);
+    EXPECT_EQ(0, fired_);
+    executor_->advanceClock(1ms);
+    EXPECT_EQ(1, fired_);
+    EXPECT_EQ(0u, executor_->queuedSchedulerTasks());
+}
+
+TEST_F(TimerTest, shouldMoveDeadlineForward)
+{
+    timer_->reset(10ms);
+    timer_->reset(5ms);
+    EXPECT_EQ(1u, executor_->queuedSchedulerTasks());
+
+    executor_->advanceClock(5ms);
+    EXPECT_EQ(1, fired_);
+    executor_->advanceClock(10ms);
+    EXPECT_EQ(1, fired_);
+}
+
+TEST_F(TimerTest, shouldNotFireWhenCancelled)
+{
+    timer_->reset(10ms);
+    EXPECT_TRUE(timer_->cancel());
+    EXPECT_FALSE(timer_->cancel());
+    EXPECT_FALSE(timer_->is_armed());
+    EXPECT_EQ(0u, executor_->queuedSchedulerTasks());
+
+    executor_->advanceClock(20ms);
+    EXPECT_EQ(0, fired_);
+}
+
+TEST_F(TimerTest, shouldBeRestartableAfterFiring)
+{
+    timer_->reset(10ms);
+    executor_->advanceClock(10ms);
+    timer_->reset(10ms);
+    executor_->advanceClock(10ms);
+    EXPECT_EQ(2, fired_);
+}
+
+TEST_F(TimerTest, shouldBeRestartableAfterCancel)
+{
+    timer_->reset(10ms);
+    timer_->cancel();
+    timer_->reset(20ms);
+    executor_->advanceClock(20ms);
+    EXPECT_EQ(1, fired_);
+}
+
+TEST_F(TimerTest, shouldNotFireWhenDestroyed)
+{
+    timer_->reset(10ms);
+    timer_.reset();
+    executor_->advanceClock(20ms);
+    EXPECT_EQ(0, fired_);
+}
+
+} // namespace asyncly
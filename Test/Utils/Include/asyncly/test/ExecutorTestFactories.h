@@ -27,12 +27,20 @@
 #include "asyncly/executor/IExecutor.h"
 #include "asyncly/executor/ThreadPoolExecutorController.h"
 #include "asyncly/scheduler/AsioScheduler.h"
+#include "asyncly/scheduler/ShardedScheduler.h"
+#include "asyncly/scheduler/TimerFdScheduler.h"
+#include "asyncly/scheduler/TimingWheelScheduler.h"
 #include "asyncly/test/SchedulerProvider.h"
 
 namespace asyncly::test {
 
 using SchedulerProviderDefault = SchedulerProviderExternal<DefaultScheduler>;
 using SchedulerProviderAsio = SchedulerProviderExternal<AsioScheduler>;
+using SchedulerProviderTimingWheel = SchedulerProviderExternal<TimingWheelScheduler>;
+using SchedulerProviderSharded = SchedulerProviderExternal<ShardedScheduler>;
+#if defined(__linux__)
+using SchedulerProviderTimerFd = SchedulerProviderExternal<TimerFdScheduler>;
+#endif
 
 template <class SchedulerProvider = SchedulerProviderNone> class AsioExecutorFactory {
   public:
@@ -71,6 +79,27 @@ class DefaultExecutorFactory {
     SchedulerProvider schedulerProvider_;
 };
 
+template <size_t threads = 1> class WorkerTimersExecutorFactory {
+  public:
+    WorkerTimersExecutorFactory()
+    {
+        ThreadPoolConfig config;
+        for (size_t i = 0; i < threads; i++) {
+            config.executorInitFunctions.emplace_back([]() {});
+        }
+        config.workerTimers = true;
+        executorController_ = ThreadPoolExecutorController::create(config);
+    }
+
+    IExecutorPtr create()
+    {
+        return executorController_->get_executor();
+    }
+
+  private:
+    std::unique_ptr<IExecutorController> executorController_;
+};
+
 template <class SchedulerProvider = SchedulerProviderNone> class ExternalEventExecutorFactory {
   public:
     ExternalEventExecutorFactory()
@@ -46,6 +46,19 @@ class FakeClockScheduler : public IScheduler {
     std::shared_ptr<Cancelable> execute_after(
         const IExecutorWPtr& executor, const clock_type::duration& relTime, Task&&) override;
 
+    std::shared_ptr<Cancelable> execute_at_with_slack(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& absTime,
+        const clock_type::duration& slack,
+        Task&&) override;
+
+    std::shared_ptr<Cancelable> execute_periodically(
+        const IExecutorWPtr& executor,
+        const clock_type::time_point& firstExpiry,
+        const clock_type::duration& period,
+        CatchUpPolicy policy,
+        RepeatableTask&&) override;
+
   private:
     BaseScheduler m_baseScheduler;
     clock_type::time_point m_mockedNow;
@@ -115,4 +128,26 @@ inline std::shared_ptr<Cancelable> FakeClockScheduler::execute_after(
     std::unique_lock<std::mutex> lock(m_scheduledMutex);
     return m_baseScheduler.execute_after(executor, relTime, std::move(task));
 }
+
+inline std::shared_ptr<Cancelable> FakeClockScheduler::execute_at_with_slack(
+    const IExecutorWPtr& executor,
+    const clock_type::time_point& absTime,
+    const clock_type::duration& slack,
+    Task&& task)
+{
+    std::unique_lock<std::mutex> lock(m_scheduledMutex);
+    return m_baseScheduler.execute_at_with_slack(executor, absTime, slack, std::move(task));
+}
+
+inline std::shared_ptr<Cancelable> FakeClockScheduler::execute_periodically(
+    const IExecutorWPtr& executor,
+    const clock_type::time_point& firstExpiry,
+    const clock_type::duration& period,
+    CatchUpPolicy policy,
+    RepeatableTask&& task)
+{
+    std::unique_lock<std::mutex> lock(m_scheduledMutex);
+    return m_baseScheduler.execute_periodically(
+        executor, firstExpiry, period, policy, std::move(task));
+}
 } // namespace asyncly::test